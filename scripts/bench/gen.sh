@@ -0,0 +1,88 @@
+#!/bin/sh
+#
+# Sweep level generation over every stage with the test frontend.
+#
+# Usage: scripts/bench/gen.sh [-j jobs] [-n levels] [-s seed] [path/to/faangband]
+#
+# Needs a build configured with --enable-test, run from the top of the
+# source tree.  The 412 stages are split into one contiguous range per job,
+# each generated in its own process; the "bench-gen" lines for every stage
+# are printed in stage order.  Totals per stage type are printed by each
+# job as "bench-gen-type" lines, which are summed here.
+
+JOBS=1
+LEVELS=10
+SEED=1
+NUM_STAGES=412
+
+while getopts j:n:s: opt; do
+	case $opt in
+		j) JOBS=$OPTARG ;;
+		n) LEVELS=$OPTARG ;;
+		s) SEED=$OPTARG ;;
+		*) echo "Usage: $0 [-j jobs] [-n levels] [-s seed] [game]" >&2
+		   exit 1 ;;
+	esac
+done
+shift $((OPTIND - 1))
+
+GAME=${1:-src/faangband}
+
+LC_ALL=${BENCH_LOCALE:-C.UTF-8}
+export LC_ALL
+
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+
+per=$(( (NUM_STAGES + JOBS - 1) / JOBS ))
+job=0
+while [ $job -lt $JOBS ]; do
+	first=$((job * per))
+	last=$((first + per - 1))
+	[ $last -ge $NUM_STAGES ] && last=$((NUM_STAGES - 1))
+
+	mkdir "$tmp/$job"
+	cat > "$tmp/$job/script" <<END
+seed $SEED
+key escape
+player-birth Female Adan Warrior
+option auto_more yes
+bench-gen $LEVELS $first $last
+END
+	"$GAME" -n -mtest -dsave="$tmp/$job" -duser="$tmp/$job" -- \
+		< "$tmp/$job/script" > "$tmp/$job/out" &
+
+	job=$((job + 1))
+done
+wait
+
+cat "$tmp"/*/out | grep '^bench-gen ' | sort -t= -k2 -n
+
+# Sum the per-type totals of all the jobs
+cat "$tmp"/*/out | grep '^bench-gen-type ' | awk '
+{
+	for (i = 2; i <= NF; i++) {
+		split($i, kv, "=");
+		if (kv[1] == "type") {
+			type = kv[2];
+			if (!(type in seen)) { seen[type] = 1; order[n++] = type; }
+		} else if (kv[1] != "levels_per_sec") {
+			sum[type, kv[1]] += kv[2];
+			if (!((type, kv[1]) in key)) {
+				key[type, kv[1]] = 1;
+				keys[type, nk[type]++] = kv[1];
+			}
+		}
+	}
+}
+END {
+	for (t = 0; t < n; t++) {
+		type = order[t];
+		line = "bench-gen-type type=" type;
+		for (k = 0; k < nk[type]; k++)
+			line = line " " keys[type, k] "=" sum[type, keys[type, k]];
+		secs = sum[type, "seconds"];
+		line = line " levels_per_sec=" (secs > 0 ? sprintf("%.1f", sum[type, "levels"] / secs) : 0);
+		print line;
+	}
+}'
@@ -0,0 +1,118 @@
+#!/bin/sh
+#
+# Design many complete sets of random artifacts with the test frontend and
+# summarise them.
+#
+# Usage: scripts/bench/randart.sh [-j jobs] [-n sets] [-s seed] [-o file.csv]
+#                                 [path/to/faangband]
+#
+# Needs a build configured with --enable-test, run from the top of the
+# source tree.  The sets are split evenly between the jobs, each designing
+# its share in its own process from seed+job.  One CSV row per set is
+# written to the -o file (or stdout), then the "bench-randart-flag" counts
+# and "bench-randart" totals of all the jobs are summed.
+
+JOBS=1
+SETS=100
+SEED=1
+CSV=
+
+while getopts j:n:s:o: opt; do
+	case $opt in
+		j) JOBS=$OPTARG ;;
+		n) SETS=$OPTARG ;;
+		s) SEED=$OPTARG ;;
+		o) CSV=$OPTARG ;;
+		*) echo "Usage: $0 [-j jobs] [-n sets] [-s seed] [-o csv] [game]" >&2
+		   exit 1 ;;
+	esac
+done
+shift $((OPTIND - 1))
+
+GAME=${1:-src/faangband}
+
+LC_ALL=${BENCH_LOCALE:-C.UTF-8}
+export LC_ALL
+
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+
+per=$(( (SETS + JOBS - 1) / JOBS ))
+job=0
+left=$SETS
+while [ $job -lt $JOBS ] && [ $left -gt 0 ]; do
+	n=$per
+	[ $n -gt $left ] && n=$left
+	left=$((left - n))
+
+	mkdir "$tmp/$job"
+	cat > "$tmp/$job/script" <<END
+seed $((SEED + job))
+key escape
+player-birth Female Adan Warrior
+bench-randart $n
+END
+	"$GAME" -n -mtest -dsave="$tmp/$job" -duser="$tmp/$job" -- \
+		< "$tmp/$job/script" > "$tmp/$job/out" &
+
+	job=$((job + 1))
+done
+wait
+
+# One row per set, tagged with the job that designed it
+for out in "$tmp"/*/out; do
+	job=$(basename "$(dirname "$out")")
+	grep '^bench-randart-set ' "$out" | awk -v job="$job" '
+	{
+		line = job;
+		for (i = 2; i <= NF; i++) {
+			split($i, kv, "=");
+			line = line "," kv[2];
+		}
+		print line;
+	}'
+done | sort -t, -k1,1n -k2,2n | awk '
+BEGIN {
+	print "job,set,artifacts,potential,spent,unspent,qualities,cursed,mean_level";
+}
+{ print }' > "$tmp/sets.csv"
+
+if [ -n "$CSV" ]; then
+	cp "$tmp/sets.csv" "$CSV"
+else
+	cat "$tmp/sets.csv"
+fi
+
+# Sum the quality counts of all the jobs
+cat "$tmp"/*/out | grep '^bench-randart-flag ' | awk '
+{
+	split($2, k, "=");
+	split($3, nm, "=");
+	split($4, c, "=");
+	id = k[2] " " nm[2];
+	if (!(id in sum)) order[n++] = id;
+	sum[id] += c[2];
+}
+END {
+	for (i = 0; i < n; i++) {
+		split(order[i], part, " ");
+		print "bench-randart-flag kind=" part[1] " name=" part[2] " count=" sum[order[i]];
+	}
+}'
+
+# And the totals
+cat "$tmp"/*/out | grep '^bench-randart ' | awk '
+{
+	for (i = 2; i <= NF; i++) {
+		split($i, kv, "=");
+		sum[kv[1]] += kv[2];
+	}
+	jobs++;
+}
+END {
+	if (!jobs) exit 1;
+	rate = sum["seconds"] > 0 ? sum["sets"] / sum["seconds"] : 0;
+	printf "bench-randart jobs=%d sets=%d seconds=%.6f potential=%d spent=%d unspent=%d sets_per_sec=%.1f\n",
+	       jobs, sum["sets"], sum["seconds"], sum["potential"], sum["spent"],
+	       sum["unspent"], rate;
+}'
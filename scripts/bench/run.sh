@@ -0,0 +1,31 @@
+#!/bin/sh
+#
+# Replay the benchmark scripts through the test frontend.
+#
+# Usage: scripts/bench/run.sh [path/to/faangband] [script.txt ...]
+#
+# Needs a build configured with --enable-test.  Run it from the top of the
+# source tree so the game finds lib/.  Each run gets a fresh save directory,
+# so the birth is the same every time, and prints "bench-*" lines of
+# key=value pairs, each prefixed with "script=<name>".  Configure with
+# ALLOW_PROFILING in src/config.h to get per-section counters as well.
+
+GAME=${1:-src/faangband}
+[ $# -gt 0 ] && shift
+
+DIR=$(dirname "$0")
+[ $# -eq 0 ] && set -- "$DIR"/*.txt
+
+# The game requires a UTF-8 locale
+LC_ALL=${BENCH_LOCALE:-C.UTF-8}
+export LC_ALL
+
+for script in "$@"; do
+	name=$(basename "$script" .txt)
+	tmp=$(mktemp -d) || exit 1
+
+	"$GAME" -n -mtest -dsave="$tmp" -duser="$tmp" -- < "$script" |
+		sed -n "s/^\(bench-[a-z]*\) /\1 script=$name /p"
+
+	rm -rf "$tmp"
+done
@@ -28,6 +28,7 @@
 #include "z-bitflag.h"
 #include "z-quark.h"
 #include "z-msg.h"
+#include "z-prof.h"
 
 /*
  * Include the high-level includes.
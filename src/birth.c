@@ -849,6 +849,7 @@ static void recalculate_stats(int *stats, int points_left)
 	event_signal(EVENT_AC);
 	event_signal(EVENT_HP);
 	event_signal(EVENT_STATS);
+	event_signal(EVENT_END);
 }
 
 static void reset_stats(int stats[A_MAX], int points_spent[A_MAX],
@@ -1389,6 +1390,7 @@ void player_birth(bool quickstart_allowed)
 			event_signal(EVENT_AC);
 			event_signal(EVENT_HP);
 			event_signal(EVENT_STATS);
+			event_signal(EVENT_END);
 
 			/* Give the UI some dummy info about the points situation. */
 			points_left = 0;
@@ -1412,6 +1414,7 @@ void player_birth(bool quickstart_allowed)
 			event_signal(EVENT_AC);
 			event_signal(EVENT_HP);
 			event_signal(EVENT_STATS);
+			event_signal(EVENT_END);
 		} else if (cmd->command == CMD_NAME_CHOICE) {
 			/* Set player name */
 			my_strcpy(op_ptr->full_name, cmd->arg[0].string,
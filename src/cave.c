@@ -1246,6 +1246,7 @@ void note_spot(int y, int x)
 		 o_ptr = get_next_object(o_ptr)) {
 		/* Memorize objects */
 		o_ptr->marked = TRUE;
+		obj_seen_add(o_ptr - o_list);
 	}
 
 
@@ -1260,6 +1261,60 @@ void note_spot(int y, int x)
 
 
 
+/*
+ * What each grid looked like when it was last drawn.  An entry stays good
+ * until light_spot() is called for its grid, or forget_map_glyphs() for the
+ * whole map, which is what happens whenever something about a grid changes.
+ */
+static struct map_glyph {
+	int a;
+	wchar_t c;
+	byte ta;
+	wchar_t tc;
+	u32b stamp;
+} map_glyphs[DUNGEON_HGT][DUNGEON_WID];
+
+static u32b map_glyph_stamp = 1;
+
+/**
+ * Find the attr/char pair to draw for a grid, and the one for the terrain
+ * under it, as map_info() and grid_data_as_text() would.
+ */
+void map_glyph(int y, int x, int *ap, wchar_t *cp, byte *tap, wchar_t *tcp)
+{
+	struct map_glyph *m = &map_glyphs[y][x];
+
+	/* Hallucination is different every time */
+	if ((m->stamp != map_glyph_stamp) || p_ptr->timed[TMD_IMAGE]) {
+		grid_data g;
+
+		map_info(y, x, &g);
+		grid_data_as_text(&g, &m->a, &m->c, &m->ta, &m->tc);
+		m->stamp = map_glyph_stamp;
+	}
+
+	(*ap) = m->a;
+	(*cp) = m->c;
+	(*tap) = m->ta;
+	(*tcp) = m->tc;
+}
+
+/**
+ * Forget what every grid looks like, for changes that are not made known
+ * grid by grid through light_spot().
+ */
+void forget_map_glyphs(void)
+{
+	/* Start again when the stamp wraps */
+	if (!++map_glyph_stamp) {
+		memset(map_glyphs, 0, sizeof(map_glyphs));
+		map_glyph_stamp = 1;
+	}
+
+	/* The small-scale map has to look again too */
+	display_map_note(-1, -1);
+}
+
 /**
  * Redraw (on the screen) a given MAP location
  *
@@ -1267,6 +1322,7 @@ void note_spot(int y, int x)
  */
 void light_spot(int y, int x)
 {
+	map_glyphs[y][x].stamp = 0;
 	event_signal_point(EVENT_MAP, x, y);
 }
 
@@ -1278,7 +1334,6 @@ static void prt_map_aux(void)
 	wchar_t c;
 	byte ta;
 	wchar_t tc;
-	grid_data g;
 
 	int y, x;
 	int vy, vx;
@@ -1315,8 +1370,7 @@ static void prt_map_aux(void)
 					continue;
 
 				/* Determine what is there */
-				map_info(y, x, &g);
-				grid_data_as_text(&g, &a, &c, &ta, &tc);
+				map_glyph(y, x, &a, &c, &ta, &tc);
 				Term_queue_char(t, vx, vy, a, c, ta, tc);
 
 				if ((tile_width > 1) || (tile_height > 1)) {
@@ -1343,7 +1397,6 @@ void prt_map(void)
 	wchar_t c;
 	byte ta;
 	wchar_t tc;
-	grid_data g;
 
 	int y, x;
 	int vy, vx;
@@ -1364,8 +1417,7 @@ void prt_map(void)
 				continue;
 
 			/* Determine what is there */
-			map_info(y, x, &g);
-			grid_data_as_text(&g, &a, &c, &ta, &tc);
+			map_glyph(y, x, &a, &c, &ta, &tc);
 
 			/* Hack -- Queue it */
 			Term_queue_char(Term, vx, vy, a, c, ta, tc);
@@ -1399,46 +1451,193 @@ void prt_map(void)
 #define MAP_WID (DUNGEON_WID / RATIO)
 
 
+/*
+ * display_map() keeps what it shows between calls.  Every grid of the level
+ * has its priority and map glyph worked out once, and each cell of a map
+ * remembers which of its grids is showing.  Changes to the map are noted
+ * by display_map_note() as they happen, so that only the grids that have
+ * changed, and the cells they are in, need looking at again.
+ */
+
 /**
- * Display a "small-scale" map of the dungeon in the active Term
- *
- * Note that the "map_info()" function must return fully colorized
- * data or this function will not work correctly.
- *
- * Note that this function must "disable" the special lighting
- * effects so that the "priority" function will work.
- *
- * Note the use of a specialized "priority" function to allow this
- * function to work with any graphic attr/char mappings, and the
- * attempts to optimize this function where possible.
- *
- * cx and cy are offsets from the position of the player.  This
- * allows the map to be shifted around - but only works in the
- * wilderness.  cx and cy return the position of the player on the
- * possibly shifted map.
+ * The most changes kept; any more and everything is worked out afresh
  */
-void display_map(int *cy, int *cx)
-{
-	int py = p_ptr->py;
-	int px = p_ptr->px;
+#define MAP_LOG_MAX 1024
 
+/**
+ * Grids that have changed, most recent last
+ */
+static struct {
+	byte y, x;
+} map_log[MAP_LOG_MAX];
+
+static u32b map_log_count;	/* Changes noted so far */
+static u32b map_log_all;	/* map_log_count when the whole map changed */
+
+/**
+ * The priority of every grid on the map and what it looks like when lit
+ */
+static struct map_grid {
+	byte priority;
+	int a;
+	wchar_t c;
+	byte ta;
+	wchar_t tc;
+} map_grids[DUNGEON_HGT][DUNGEON_WID];
+
+static u32b map_grids_seen;	/* map_log_count when map_grids was updated */
+static bool map_grids_valid = FALSE;
+
+/**
+ * A map as shown in one term
+ */
+struct map_view {
+	term *t;
+	bool valid;
+	u32b seen;		/* map_log_count when it was last shown */
+
+	/* How the level is fitted into the term */
 	int map_hgt, map_wid;
-	int dungeon_hgt, dungeon_wid, top_row, left_col;
-	int row, col;
+	int dungeon_hgt, dungeon_wid;
+	int top_row, left_col;
+	int tile_hgt, tile_wid;
 
-	int x, y;
-	grid_data g;
+	/* The grids in each row and column of cells, or -1 for none */
+	s16b y_first[DUNGEON_HGT], y_last[DUNGEON_HGT];
+	s16b x_first[DUNGEON_WID], x_last[DUNGEON_WID];
+
+	/* The grid showing in each cell, as y * DUNGEON_WID + x, or -1 */
+	s16b *shown;
+
+	/* Cells to look at again */
+	bool *dirty;
+	u16b *todo;
+	int num_todo;
+
+	int prow, pcol;	/* Where the player was drawn */
+};
+
+static struct map_view map_views[ANGBAND_TERM_MAX];
+
+/**
+ * Note that a grid has changed since display_map() last looked at it, or
+ * that they all have, if y and x are both -1.
+ */
+void display_map_note(int y, int x)
+{
+	if ((y < 0) || (x < 0)) {
+		map_log_all = ++map_log_count;
+		return;
+	}
+
+	map_log_count++;
+	map_log[map_log_count % MAP_LOG_MAX].y = y;
+	map_log[map_log_count % MAP_LOG_MAX].x = x;
+}
 
+/**
+ * Whether the changes since a given count have to be worked out by looking
+ * at the whole map
+ */
+static bool map_log_lost(u32b seen)
+{
+	u32b since = map_log_count - seen;
+
+	return ((since > MAP_LOG_MAX) || (map_log_count - map_log_all < since));
+}
+
+/**
+ * Work out the priority and glyph of a grid.
+ *
+ * Note that this function must "disable" the special lighting effects so
+ * that the "priority" function will work.
+ */
+static void map_grid_update(int y, int x)
+{
+	struct map_grid *m = &map_grids[y][x];
+	grid_data g;
 	int a;
 	byte ta;
 	wchar_t c, tc;
 
-	byte tp;
+	/* Get the attr/char at that map location */
+	map_info(y, x, &g);
+	grid_data_as_text(&g, &a, &c, &ta, &tc);
 
-	/* Large array on the stack */
-	byte mp[DUNGEON_HGT][DUNGEON_WID];
+	/* Get the priority of that feature */
+	m->priority = f_info[g.f_idx].priority;
 
-	monster_race *r_ptr = &r_info[0];
+	/* Stuff on top of terrain gets higher priority */
+	if ((a != ta) || (c != tc))
+		m->priority = 20;
+
+	/* Hack - make every grid on the map lit */
+	g.lighting = FEAT_LIGHTING_LIT;	/*FEAT_LIGHTING_BRIGHT; */
+	grid_data_as_text(&g, &m->a, &m->c, &m->ta, &m->tc);
+}
+
+/**
+ * Bring map_grids up to date.
+ */
+static void map_grids_update(void)
+{
+	u32b i;
+	int y, x;
+
+	if (map_grids_valid && !map_log_lost(map_grids_seen)) {
+		for (i = map_grids_seen + 1; i != map_log_count + 1; i++)
+			map_grid_update(map_log[i % MAP_LOG_MAX].y,
+							map_log[i % MAP_LOG_MAX].x);
+	} else {
+		for (y = 0; y < DUNGEON_HGT; y++)
+			for (x = 0; x < DUNGEON_WID; x++)
+				map_grid_update(y, x);
+		map_grids_valid = TRUE;
+	}
+
+	map_grids_seen = map_log_count;
+}
+
+/**
+ * Find the cell a grid is shown in, or return -1 if it isn't shown.
+ */
+static int map_view_cell(const struct map_view *v, int y, int x)
+{
+	int row, col;
+
+	if ((y < v->top_row) || (y >= v->dungeon_hgt) || (x < v->left_col)
+		|| (x >= v->dungeon_wid))
+		return (-1);
+
+	row = ((y - v->top_row) * v->map_hgt / v->dungeon_hgt);
+	col = ((x - v->left_col) * v->map_wid / v->dungeon_wid);
+
+	if (v->tile_wid > 1)
+		col = col - (col % v->tile_wid);
+	if (v->tile_hgt > 1)
+		row = row - (row % v->tile_hgt);
+
+	return (row * v->map_wid + col);
+}
+
+static void map_view_mark(struct map_view *v, int cell)
+{
+	if ((cell < 0) || v->dirty[cell])
+		return;
+
+	v->dirty[cell] = TRUE;
+	v->todo[v->num_todo++] = cell;
+}
+
+/**
+ * Fit the level into the active term, as it is now.  Returns FALSE if it
+ * doesn't fit at all.
+ */
+static bool map_view_fit(struct map_view *v)
+{
+	int map_hgt, map_wid;
+	int dungeon_hgt, dungeon_wid, top_row, left_col;
+	int y, x;
 
 	/* Desired map height */
 	map_hgt = Term->hgt - 2;
@@ -1461,70 +1660,175 @@ void display_map(int *cy, int *cx)
 
 	/* Prevent accidents */
 	if ((map_wid < 1) || (map_hgt < 1))
+		return (FALSE);
+
+	/* Same as last time */
+	if (v->valid && (v->map_hgt == map_hgt) && (v->map_wid == map_wid)
+		&& (v->dungeon_hgt == dungeon_hgt) && (v->dungeon_wid == dungeon_wid)
+		&& (v->top_row == top_row) && (v->left_col == left_col)
+		&& (v->tile_hgt == tile_height) && (v->tile_wid == tile_width))
+		return (TRUE);
+
+	v->map_hgt = map_hgt;
+	v->map_wid = map_wid;
+	v->dungeon_hgt = dungeon_hgt;
+	v->dungeon_wid = dungeon_wid;
+	v->top_row = top_row;
+	v->left_col = left_col;
+	v->tile_hgt = tile_height;
+	v->tile_wid = tile_width;
+
+	/* Find the grids in each row and column of cells */
+	for (y = 0; y < DUNGEON_HGT; y++)
+		v->y_first[y] = v->y_last[y] = -1;
+	for (x = 0; x < DUNGEON_WID; x++)
+		v->x_first[x] = v->x_last[x] = -1;
+
+	for (y = top_row; y < dungeon_hgt; y++) {
+		int row = map_view_cell(v, y, left_col) / map_wid;
+
+		if (v->y_first[row] < 0)
+			v->y_first[row] = y;
+		v->y_last[row] = y;
+	}
+
+	for (x = left_col; x < dungeon_wid; x++) {
+		int col = map_view_cell(v, top_row, x) % map_wid;
+
+		if (v->x_first[col] < 0)
+			v->x_first[col] = x;
+		v->x_last[col] = x;
+	}
+
+	v->shown = mem_realloc(v->shown, map_hgt * map_wid * sizeof(s16b));
+	v->dirty = mem_realloc(v->dirty, map_hgt * map_wid * sizeof(bool));
+	v->todo = mem_realloc(v->todo, map_hgt * map_wid * sizeof(u16b));
+
+	/* Nothing is known about the new cells */
+	v->valid = FALSE;
+
+	return (TRUE);
+}
+
+/**
+ * Find the highest priority grid in a cell, the first one if several
+ * share it.
+ */
+static void map_view_update_cell(struct map_view *v, int cell)
+{
+	int row = cell / v->map_wid, col = cell % v->map_wid;
+	int y, x;
+	byte best = 0;
+
+	v->shown[cell] = -1;
+	if ((v->y_first[row] < 0) || (v->x_first[col] < 0))
 		return;
 
-	/* Nothing here */
-	a = TERM_WHITE;
-	c = L' ';
-	ta = TERM_WHITE;
-	tc = L' ';
-
-	/* Clear the priorities */
-	for (y = 0; y < map_hgt; ++y) {
-		for (x = 0; x < map_wid; ++x) {
-			/* No priority */
-			mp[y][x] = 0;
+	for (y = v->y_first[row]; y <= v->y_last[row]; y++) {
+		for (x = v->x_first[col]; x <= v->x_last[col]; x++) {
+			if (map_grids[y][x].priority > best) {
+				best = map_grids[y][x].priority;
+				v->shown[cell] = y * DUNGEON_WID + x;
+			}
 		}
 	}
+}
 
-	/* Draw a box around the edge of the term */
-	window_make(0, 0, map_wid + 1, map_hgt + 1);
+static void map_view_draw_cell(const struct map_view *v, int cell)
+{
+	int row = cell / v->map_wid, col = cell % v->map_wid;
+	const struct map_grid *m;
 
-	/* Analyze the actual map */
-	for (y = top_row; y < dungeon_hgt; y++) {
-		for (x = left_col; x < dungeon_wid; x++) {
-			row = ((y - top_row) * map_hgt / dungeon_hgt);
-			col = ((x - left_col) * map_wid / dungeon_wid);
+	/* Not a cell, when tiles take up several */
+	if ((v->y_first[row] < 0) || (v->x_first[col] < 0))
+		return;
 
-			if (tile_width > 1) {
-				col = col - (col % tile_width);
-			}
-			if (tile_height > 1) {
-				row = row - (row % tile_height);
-			}
+	if (v->shown[cell] < 0) {
+		Term_queue_char(Term, col + 1, row + 1, TERM_WHITE, L' ', 0, 0);
+	} else {
+		m = &map_grids[v->shown[cell] / DUNGEON_WID]
+			[v->shown[cell] % DUNGEON_WID];
+		Term_queue_char(Term, col + 1, row + 1, m->a, m->c, m->ta, m->tc);
+	}
 
-			/* Get the attr/char at that map location */
-			map_info(y, x, &g);
-			grid_data_as_text(&g, &a, &c, &ta, &tc);
+	if ((v->tile_wid > 1) || (v->tile_hgt > 1))
+		Term_big_queue_char(Term, col + 1, row + 1, 255, -1, 0, 0);
+}
 
-			/* Get the priority of that feature */
-			tp = f_info[g.f_idx].priority;
+/**
+ * Display the map in the active term, everything if all is TRUE, and
+ * otherwise only what has changed since the last time.
+ */
+static void display_map_aux(int *cy, int *cx, bool all)
+{
+	struct map_view *v = NULL;
+	int i, cell, row, col;
+	u32b n;
 
-			/* Stuff on top of terrain gets higher priority */
-			if ((a != ta) || (c != tc))
-				tp = 20;
+	monster_race *r_ptr = &r_info[0];
 
-			/* Save "best" */
-			if (mp[row][col] < tp) {
-				/* Hack - make every grid on the map lit */
-				g.lighting = FEAT_LIGHTING_LIT;	/*FEAT_LIGHTING_BRIGHT; */
-				grid_data_as_text(&g, &a, &c, &ta, &tc);
+	/* Find the map for this term, or a free one */
+	for (i = 0; i < ANGBAND_TERM_MAX; i++) {
+		if (map_views[i].t == Term) {
+			v = &map_views[i];
+			break;
+		}
+		if (!v && !map_views[i].t)
+			v = &map_views[i];
+	}
+	if (!v) {
+		v = &map_views[0];
+		v->valid = FALSE;
+	}
+	v->t = Term;
 
-				Term_queue_char(Term, col + 1, row + 1, a, c, ta, tc);
+	if (!map_view_fit(v))
+		return;
 
-				if ((tile_width > 1) || (tile_height > 1))
-					Term_big_queue_char(Term, col + 1, row + 1, 255, -1, 0, 0);
+	map_grids_update();
 
-				/* Save priority */
-				mp[row][col] = tp;
-			}
+	/* Look at the cells with changed grids, or at everything */
+	if (!v->valid || map_log_lost(v->seen)) {
+		for (cell = 0; cell < v->map_hgt * v->map_wid; cell++) {
+			map_view_update_cell(v, cell);
+			v->dirty[cell] = FALSE;
 		}
+		v->num_todo = 0;
+		v->prow = v->pcol = -1;
+		v->valid = TRUE;
+		all = TRUE;
+	} else {
+		for (n = v->seen + 1; n != map_log_count + 1; n++)
+			map_view_mark(v, map_view_cell(v, map_log[n % MAP_LOG_MAX].y,
+											map_log[n % MAP_LOG_MAX].x));
+		for (i = 0; i < v->num_todo; i++)
+			map_view_update_cell(v, v->todo[i]);
 	}
+	v->seen = map_log_count;
+
+	/* The player has moved off a cell */
+	cell = map_view_cell(v, p_ptr->py, p_ptr->px);
+	if ((v->prow >= 0) && (v->prow * v->map_wid + v->pcol != cell))
+		map_view_mark(v, v->prow * v->map_wid + v->pcol);
+
+	if (all) {
+		/* Draw a box around the edge of the term */
+		window_make(0, 0, v->map_wid + 1, v->map_hgt + 1);
 
+		for (cell = 0; cell < v->map_hgt * v->map_wid; cell++)
+			map_view_draw_cell(v, cell);
+	} else {
+		for (i = 0; i < v->num_todo; i++)
+			map_view_draw_cell(v, v->todo[i]);
+	}
+
+	for (i = 0; i < v->num_todo; i++)
+		v->dirty[v->todo[i]] = FALSE;
+	v->num_todo = 0;
 
 	/* Player location */
-	row = ((py - top_row) * map_hgt / dungeon_hgt);
-	col = ((px - left_col) * map_wid / dungeon_wid);
+	row = ((p_ptr->py - v->top_row) * v->map_hgt / v->dungeon_hgt);
+	col = ((p_ptr->px - v->left_col) * v->map_wid / v->dungeon_wid);
 
 	if (tile_width > 1) {
 		col = col - (col % tile_width);
@@ -1533,19 +1837,16 @@ void display_map(int *cy, int *cx)
 		row = row - (row % tile_height);
 	}
 
-  /*** Make sure the player is visible ***/
-
-	/* Get the "player" attr */
-	ta = r_ptr->x_attr;
+	v->prow = row;
+	v->pcol = col;
 
-	/* Get the "player" char */
-	tc = r_ptr->x_char;
+  /*** Make sure the player is visible ***/
 
 	/* Draw the player */
-	Term_putch(col + 1, row + 1, ta, tc);
+	Term_putch(col + 1, row + 1, r_ptr->x_attr, r_ptr->x_char);
 
 	if ((tile_width > 1) || (tile_height > 1)) {
-		Term_big_putch(col + 1, row + 1, ta, tc);
+		Term_big_putch(col + 1, row + 1, r_ptr->x_attr, r_ptr->x_char);
 	}
 
 	/* Return player location */
@@ -1555,6 +1856,51 @@ void display_map(int *cy, int *cx)
 		(*cx) = col + 1;
 }
 
+/**
+ * Display a "small-scale" map of the dungeon in the active Term
+ *
+ * Note that the "map_info()" function must return fully colorized
+ * data or this function will not work correctly.
+ *
+ * Note the use of a specialized "priority" function to allow this
+ * function to work with any graphic attr/char mappings, and the
+ * attempts to optimize this function where possible.
+ *
+ * cx and cy are offsets from the position of the player.  This
+ * allows the map to be shifted around - but only works in the
+ * wilderness.  cx and cy return the position of the player on the
+ * possibly shifted map.
+ */
+void display_map(int *cy, int *cx)
+{
+	display_map_aux(cy, cx, TRUE);
+}
+
+/**
+ * Redraw whatever has changed since display_map() or this function last
+ * drew the map in the active Term.
+ */
+void display_map_changes(void)
+{
+	display_map_aux(NULL, NULL, FALSE);
+}
+
+/**
+ * Free the maps kept by display_map().
+ */
+void free_display_map(void)
+{
+	int i;
+
+	for (i = 0; i < ANGBAND_TERM_MAX; i++) {
+		FREE(map_views[i].shown);
+		FREE(map_views[i].dirty);
+		FREE(map_views[i].todo);
+		map_views[i].t = NULL;
+		map_views[i].valid = FALSE;
+	}
+}
+
 /**
  * Display a map of the type of wilderness surrounding the current stage
  */
@@ -2026,6 +2372,8 @@ void forget_view(void)
 {
 	int x, y;
 
+	forget_player_field();
+
 	for (y = 0; y < CAVE_INFO_Y; y++) {
 		for (x = 0; x < CAVE_INFO_X; x++) {
 			if (!sqinfo_has(cave_info[y][x], SQUARE_VIEW))
@@ -2184,6 +2532,10 @@ void update_view(void)
 
 	int radius;
 
+	PROF_BEGIN(UPDATE_VIEW);
+
+	forget_player_field();
+
 	mark_wasseen();
 
 	/* Extract "radius" value */
@@ -2213,6 +2565,8 @@ void update_view(void)
 	for (y = 0; y < CAVE_INFO_Y; y++)
 		for (x = 0; x < CAVE_INFO_X; x++)
 			update_one(y, x, p_ptr->timed[TMD_BLIND]);
+
+	PROF_END(UPDATE_VIEW);
 }
 
 
@@ -2260,6 +2614,8 @@ void update_noise(void)
 
 	byte flow_table[2][2][8 * NOISE_STRENGTH];
 
+	PROF_BEGIN(UPDATE_NOISE);
+
 	/* The character's grid has no flow info.  Do a full rebuild. */
 	if (cave_cost[p_ptr->py][p_ptr->px] == 0)
 		full = TRUE;
@@ -2296,8 +2652,10 @@ void update_noise(void)
 				/* We're in LOS of the last update - don't update again */
 				if (los
 					(p_ptr->py, p_ptr->px, update_center_y,
-					 update_center_x))
+					 update_center_x)) {
+					PROF_END(UPDATE_NOISE);
 					return;
+				}
 
 				/* We're not in LOS - update */
 				else
@@ -2513,6 +2871,8 @@ void update_noise(void)
 			next_cycle = 1;
 		}
 	}
+
+	PROF_END(UPDATE_NOISE);
 }
 
 
@@ -2551,6 +2911,8 @@ void update_smell(void)
 		{250, 2, 2, 2, 250},
 	};
 
+	PROF_BEGIN(UPDATE_SMELL);
+
 	/* Scent becomes "younger" */
 	scent_when--;
 
@@ -2610,6 +2972,8 @@ void update_smell(void)
 			cave_when[y][x] = scent_when + scent_adjust[i][j];
 		}
 	}
+
+	PROF_END(UPDATE_SMELL);
 }
 
 /**
@@ -2727,6 +3091,7 @@ void wiz_light(bool wizard)
 
 		/* Memorize */
 		o_ptr->marked = TRUE;
+		obj_seen_add(i);
 	}
 
 	/* Scan all normal grids */
@@ -2912,6 +3277,9 @@ void cave_set_feat(int y, int x, int feat)
 	/* Change the feature */
 	cave_feat[y][x] = feat;
 
+	/* Paths may have changed */
+	forget_player_field();
+
 	/* Notice/Redraw */
 	if (character_dungeon) {
 		/* Notice */
@@ -3259,6 +3627,193 @@ byte projectable(int y1, int x1, int y2, int x2, int flg)
 	return (PROJECT_NOT_CLEAR);
 }
 
+
+/**
+ * The player-projectability field.
+ *
+ * For each grid within range of the player, this remembers whether a
+ * projection from that grid reaches the player, not counting any monsters
+ * in the way.  Paths only depend on the terrain and the two end points, so
+ * an entry stays good until the player moves or the terrain changes;
+ * update_view(), forget_view() and cave_set_feat() throw the whole field
+ * away by bumping the stamp.
+ *
+ * Entries are filled in the first time a monster asks, so each monster
+ * position costs at most one project_path() between player moves, and
+ * monsters that cannot reach the player are answered without one.
+ */
+#define PFIELD_SIZE	(2 * MAX_RANGE_LGE + 1)
+
+static struct {
+	u16b stamp;		/* Field stamp when this entry was filled in */
+	byte path;		/* PROJECT_NO or PROJECT_NOT_CLEAR */
+} pfield[PFIELD_SIZE][PFIELD_SIZE];
+
+static u16b pfield_stamp = 1;
+static int pfield_py, pfield_px;
+
+/**
+ * Throw away the player-projectability field.
+ */
+void forget_player_field(void)
+{
+	/* Start again from scratch when the stamp wraps */
+	if (!++pfield_stamp) {
+		memset(pfield, 0, sizeof(pfield));
+		pfield_stamp = 1;
+	}
+}
+
+/**
+ * Equivalent to projectable(y, x, p_ptr->py, p_ptr->px, flg), for flg
+ * PROJECT_NONE or PROJECT_CHCK, using the player-projectability field.
+ */
+byte projectable_player(int y, int x, int flg)
+{
+	int py = p_ptr->py;
+	int px = p_ptr->px;
+	int fy = y - py + MAX_RANGE_LGE;
+	int fx = x - px + MAX_RANGE_LGE;
+
+	/* Out of range of the field */
+	if ((fy < 0) || (fy >= PFIELD_SIZE) || (fx < 0) || (fx >= PFIELD_SIZE))
+		return (projectable(y, x, py, px, flg));
+
+	/* The player has moved without updating the view */
+	if ((py != pfield_py) || (px != pfield_px)) {
+		forget_player_field();
+		pfield_py = py;
+		pfield_px = px;
+	}
+
+	/* Fill in the entry */
+	if (pfield[fy][fx].stamp != pfield_stamp) {
+		pfield[fy][fx].stamp = pfield_stamp;
+		pfield[fy][fx].path = projectable(y, x, py, px, PROJECT_NONE);
+	}
+
+	/* No path to the player */
+	if (pfield[fy][fx].path == PROJECT_NO)
+		return (PROJECT_NO);
+
+	/* Only a full check can see monsters in the way */
+	if (flg & (PROJECT_CHCK))
+		return (projectable(y, x, py, px, flg));
+
+	return (PROJECT_NOT_CLEAR);
+}
+
+/**
+ * Resize a region index for a list of old_size entries to size entries.
+ * The new entries are in no region.  A size of zero frees it.
+ */
+void region_resize(region_index *r, int old_size, int size)
+{
+	int i;
+
+	/* Free everything */
+	if (!size) {
+		FREE(r->next);
+		FREE(r->prev);
+		return;
+	}
+
+	r->next = mem_realloc(r->next, size * sizeof(s16b));
+	r->prev = mem_realloc(r->prev, size * sizeof(s16b));
+
+	for (i = old_size; i < size; i++)
+		r->next[i] = -1;
+}
+
+/**
+ * Empty a region index for a list of the given size
+ */
+void region_clear(region_index *r, int size)
+{
+	int i;
+
+	memset(r->head, 0, sizeof(r->head));
+
+	for (i = 0; i < size; i++)
+		r->next[i] = -1;
+}
+
+/**
+ * Add entry idx, at grid (y, x), to a region index
+ */
+void region_add(region_index *r, int idx, int y, int x)
+{
+	s16b *head = &r->head[y / REGION_GRIDS][x / REGION_GRIDS];
+
+	r->prev[idx] = 0;
+	r->next[idx] = *head;
+	if (*head)
+		r->prev[*head] = idx;
+	*head = idx;
+}
+
+/**
+ * Remove entry idx, at grid (y, x), from a region index, if it is there
+ */
+void region_remove(region_index *r, int idx, int y, int x)
+{
+	/* Not indexed */
+	if (r->next[idx] < 0)
+		return;
+
+	if (r->prev[idx])
+		r->next[r->prev[idx]] = r->next[idx];
+	else
+		r->head[y / REGION_GRIDS][x / REGION_GRIDS] = r->next[idx];
+
+	if (r->next[idx])
+		r->prev[r->next[idx]] = r->prev[idx];
+
+	r->next[idx] = -1;
+}
+
+/**
+ * Move entry idx of a region index from grid (y1, x1) to grid (y2, x2)
+ */
+void region_move(region_index *r, int idx, int y1, int x1, int y2, int x2)
+{
+	/* Same region */
+	if ((y1 / REGION_GRIDS == y2 / REGION_GRIDS)
+		&& (x1 / REGION_GRIDS == x2 / REGION_GRIDS))
+		return;
+
+	region_remove(r, idx, y1, x1);
+	region_add(r, idx, y2, x2);
+}
+
+/**
+ * Find the entries of a region index in the regions which overlap the
+ * square of grids within d of grid (y, x).  That square holds every grid
+ * whose distance() from (y, x) is at most d, so callers only need to check
+ * the distance of what is found.
+ *
+ * The indexes are put in list[], which must have room for all the entries,
+ * region by region.  Callers which care about the order they deal with
+ * things in should scan the whole list instead.  Returns the number found.
+ */
+int region_scan(const region_index *r, int y, int x, int d, s16b *list)
+{
+	int y1 = MAX(y - d, 0) / REGION_GRIDS;
+	int y2 = MIN(y + d, DUNGEON_HGT - 1) / REGION_GRIDS;
+	int x1 = MAX(x - d, 0) / REGION_GRIDS;
+	int x2 = MIN(x + d, DUNGEON_WID - 1) / REGION_GRIDS;
+	int ry, rx, i, n = 0;
+
+	for (ry = y1; ry <= y2; ry++) {
+		for (rx = x1; rx <= x2; rx++) {
+			for (i = r->head[ry][rx]; i; i = r->next[i])
+				list[n++] = i;
+		}
+	}
+
+	return (n);
+}
+
 /**
  * Standard "find me a location" function
  *
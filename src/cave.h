@@ -261,6 +261,26 @@ typedef byte byte_wid[DUNGEON_WID];
  */
 typedef s16b s16b_wid[DUNGEON_WID];
 
+/**
+ * Side of the square regions, in grids, of a region_index
+ */
+#define REGION_GRIDS	11
+#define REGION_HGT	((DUNGEON_HGT + REGION_GRIDS - 1) / REGION_GRIDS)
+#define REGION_WID	((DUNGEON_WID + REGION_GRIDS - 1) / REGION_GRIDS)
+
+/**
+ * A coarse index of the monsters or objects on the level by the region
+ * they are in, so those near a grid can be found without looking at all
+ * of them.  Each region heads a list of indexes into m_list[] or o_list[],
+ * linked through next[] and prev[], which are as large as that list; an
+ * entry which is in no region has a next[] of -1.
+ */
+typedef struct region_index {
+    s16b head[REGION_HGT][REGION_WID];
+    s16b *next;
+    s16b *prev;
+} region_index;
+
 
 extern int distance(int y1, int x1, int y2, int x2);
 extern bool los(int y1, int x1, int y2, int x2);
@@ -269,13 +289,18 @@ extern bool cave_valid_bold(int y, int x);
 extern byte get_color(byte a, int attr, int n);
 extern void grid_data_as_text(grid_data *g, int *ap, wchar_t *cp, byte *tap, wchar_t *tcp);
 extern void map_info(unsigned x, unsigned y, grid_data *g);
+extern void map_glyph(int y, int x, int *ap, wchar_t *cp, byte *tap, wchar_t *tcp);
+extern void forget_map_glyphs(void);
 extern void move_cursor_relative(int y, int x);
 extern void big_putch(int x, int y, byte a, char c);
 extern void print_rel(wchar_t c, byte a, int y, int x);
 extern void note_spot(int y, int x);
 extern void light_spot(int y, int x);
 extern void prt_map(void);
+extern void display_map_note(int y, int x);
 extern void display_map(int *cy, int *cx);
+extern void display_map_changes(void);
+extern void free_display_map(void);
 extern void do_cmd_view_map(void);
 extern void forget_view(void);
 extern void update_view(void);
@@ -289,6 +314,15 @@ extern void cave_set_feat(int y, int x, int feat);
 extern int project_path(u16b *gp, int range, \
                          int y1, int x1, int y2, int x2, int flg);
 extern byte projectable(int y1, int x1, int y2, int x2, int flg);
+extern void forget_player_field(void);
+extern byte projectable_player(int y, int x, int flg);
+extern void region_resize(region_index *r, int old_size, int size);
+extern void region_clear(region_index *r, int size);
+extern void region_add(region_index *r, int idx, int y, int x);
+extern void region_remove(region_index *r, int idx, int y, int x);
+extern void region_move(region_index *r, int idx, int y1, int x1, int y2,
+						int x2);
+extern int region_scan(const region_index *r, int y, int x, int d, s16b *list);
 extern void scatter(int *yp, int *xp, int y, int x, int d, int m);
 extern void health_track(int m_idx);
 extern void monster_race_track(int r_idx);
@@ -106,15 +106,7 @@ void do_cmd_move_house(void)
 }
 
 /** Path translations */
-
-typedef struct {
-	int path;
-	int direction;
-	int return_path;
-	bool eastwest;
-} pather;
-
-static const pather path_data[] = {
+const pather path_data[PATH_DATA_MAX] = {
 	{FEAT_LESS_NORTH, NORTH, FEAT_MORE_SOUTH, FALSE},
 	{FEAT_MORE_NORTH, NORTH, FEAT_LESS_SOUTH, FALSE},
 	{FEAT_LESS_EAST, EAST, FEAT_MORE_WEST, TRUE},
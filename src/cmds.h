@@ -58,6 +58,16 @@ extern void fall_off_cliff(void);
 extern void move_player(int dir);
 
 /* cmd2.c */
+typedef struct {
+	int path;
+	int direction;
+	int return_path;
+	bool eastwest;
+} pather;
+
+#define PATH_DATA_MAX 8
+extern const pather path_data[PATH_DATA_MAX];
+
 int count_feats(int *y, int *x, int flag, bool under);
 int count_traps(int *y, int *x);
 int count_chests(int *y, int *x, bool trapped);
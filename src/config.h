@@ -64,6 +64,12 @@
  */
 #define ALLOW_SPOILERS
 
+/*
+ * OPTION: Compile in hot-path timers and counters (see "z-prof.h"),
+ * the performance subwindow and the debug command to dump them.
+ */
+/* #define ALLOW_PROFILING */
+
 
 /*
  * OPTION: Allow "do_cmd_colors" at run-time
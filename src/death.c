@@ -826,6 +826,7 @@ void death_screen(void)
 
 	event_signal(EVENT_INVENTORY);
 	event_signal(EVENT_EQUIPMENT);
+	event_signal(EVENT_END);
 
 	/* Handle stuff */
 	notice_stuff(p_ptr);
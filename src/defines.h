@@ -161,6 +161,15 @@
  */
 #define EGO_TVALS_MAX 3
 
+/**
+ * The object and monster lists start at the sizes in limits.txt and grow
+ * by this many entries at a time, up to the hard limits below (indices
+ * are stored as s16b in the cave arrays and the savefile).
+ */
+#define POOL_CHUNK	256
+#define MAX_O_IDX	32000
+#define MAX_M_IDX	32000
+
 /**
  * Maximum number of high scores in the high score file
  */
@@ -224,6 +233,7 @@
 #define STORE_MAX_KEEP	18	/* Max slots to "always" keep full */
 #define STORE_SHUFFLE	20	/* 1/Chance (per day) of an owner changing */
 #define STORE_TURNS	1000	/* Number of turns between turnovers */
+#define STORE_MAINT_MAX	10	/* Max turnovers a store can fall behind */
 
 
 /**
@@ -548,6 +558,7 @@ enum
 #define PR_SPEED	0x00200000L	/* Display Extra (Speed) */
 #define PR_STUDY	0x00400000L	/* Display Extra (Study) */
 #define PR_DTRAP        0x00800000L     /* Display Extra (DTrap) */
+#define PR_PANEL	0x01000000L	/* Display Map, which has only moved */
 
 #define PR_MON_MANA	0x04000000L	/* Display Mana Bar */
 #define PR_MAP		0x08000000L	/* Display Map */
@@ -584,8 +595,9 @@ enum
 #define PW_ITEMLIST     0x00002000L     /* Display item list */
 #define PW_BORG_1	0x00004000L	/* Display borg messages */
 #define PW_BORG_2	0x00008000L	/* Display borg status */
+#define PW_PROFILE	0x00010000L	/* Display performance counters */
 
-#define PW_MAX_FLAGS		16
+#define PW_MAX_FLAGS		17
 
 /*
  * Bit flags for the "p_ptr->special_attack" variable. -LM-
@@ -438,6 +438,8 @@ static void process_world(void)
 	if (turn % 10)
 		return;
 
+	PROF_BEGIN(PROCESS_WORLD);
+
 	/* Play an ambient sound at regular intervals. */
 	if (!(turn % ((10L * TOWN_DAWN) / 4))) {
 		play_ambient_sound();
@@ -1304,6 +1306,8 @@ static void process_world(void)
 			disturb(0, 0);
 		}
 	}
+
+	PROF_END(PROCESS_WORLD);
 }
 
 
@@ -1424,6 +1428,93 @@ static void place_cursor(void)
 }
 
 
+/**
+ * Whether the screen can wait until the player stops running, resting or
+ * repeating a command.  The game turns still happen in full, view and
+ * monster updates included; only the redraws pile up in p_ptr->redraw,
+ * to be done once when something disturbs the player or the action ends.
+ */
+static bool screen_can_wait(void)
+{
+	if (!OPT(fast_forward))
+		return (FALSE);
+
+	return (p_ptr->running || p_ptr->resting || (cmd_get_nrepeats() > 0));
+}
+
+/**
+ * Check whether a rest until something (rather than for a number of turns)
+ * has run its course.
+ */
+static bool rest_is_over(void)
+{
+	/* Basic resting */
+	if (p_ptr->resting == -1)
+		return ((p_ptr->chp == p_ptr->mhp) && (p_ptr->csp == p_ptr->msp));
+
+	/* Complete resting */
+	if (p_ptr->resting == -2)
+		return ((p_ptr->chp == p_ptr->mhp) && (p_ptr->csp == p_ptr->msp)
+				&& !p_ptr->timed[TMD_BLIND] && !p_ptr->timed[TMD_CONFUSED]
+				&& !p_ptr->timed[TMD_POISONED] && !p_ptr->timed[TMD_AFRAID]
+				&& !p_ptr->timed[TMD_STUN] && !p_ptr->timed[TMD_CUT]
+				&& !p_ptr->timed[TMD_SLOW] && !p_ptr->timed[TMD_PARALYZED]
+				&& !p_ptr->timed[TMD_IMAGE] && !p_ptr->word_recall);
+
+	/* Resting until sunrise/set */
+	if (p_ptr->resting == -3)
+		return (!(((turn / 10) * 10) % ((10L * TOWN_DAWN) / 2)));
+
+	return (FALSE);
+}
+
+
+/**
+ * Make the noise and leave the scent of the character's latest turn.
+ */
+static void player_leaves_traces(void)
+{
+	u32b temp_wakeup_chance;
+
+	/* 
+	 * Characters are noisy.
+	 * Use the amount of extra (directed) noise the player has made 
+	 * this turn to calculate the total amount of ambiant noise.
+	 */
+	temp_wakeup_chance =
+		p_ptr->state.base_wakeup_chance + add_wakeup_chance;
+
+	/* People don't make much noise when resting. */
+	if (p_ptr->resting)
+		temp_wakeup_chance /= 2;
+
+	/* Characters hidden in shadow have almost perfect stealth. */
+	if ((p_ptr->timed[TMD_SSTEALTH]) && (!p_ptr->state.aggravate)) {
+		if (temp_wakeup_chance > 200)
+			temp_wakeup_chance = 200;
+	}
+
+
+	/* Increase noise level if necessary. */
+	if (temp_wakeup_chance > total_wakeup_chance)
+		total_wakeup_chance = temp_wakeup_chance;
+
+
+	/* Update noise flow information */
+	update_noise();
+
+	/* Update scent trail */
+	update_smell();
+
+
+	/* 
+	 * Reset character vulnerability.  Will be calculated by 
+	 * the first member of an animal pack that has a use for it.
+	 */
+	p_ptr->vulnerability = 0;
+}
+
+
 /**
  * Process the player
  *
@@ -1449,46 +1540,22 @@ static void process_player(void)
 {
 	int i;
 
-	u32b temp_wakeup_chance;
+	PROF_BEGIN(PROCESS_PLAYER);
 
 	/*** Check for interupts ***/
 
 	/* Complete resting */
-	if (p_ptr->resting < 0) {
-		/* Basic resting */
-		if (p_ptr->resting == -1) {
-			/* Stop resting */
-			if ((p_ptr->chp == p_ptr->mhp) && (p_ptr->csp == p_ptr->msp)) {
-				disturb(0, 0);
-			}
-		}
-
-		/* Complete resting */
-		else if (p_ptr->resting == -2) {
-			/* Stop resting */
-			if ((p_ptr->chp == p_ptr->mhp) && (p_ptr->csp == p_ptr->msp)
-				&& !p_ptr->timed[TMD_BLIND] && !p_ptr->timed[TMD_CONFUSED]
-				&& !p_ptr->timed[TMD_POISONED] && !p_ptr->timed[TMD_AFRAID]
-				&& !p_ptr->timed[TMD_STUN] && !p_ptr->timed[TMD_CUT]
-				&& !p_ptr->timed[TMD_SLOW] && !p_ptr->timed[TMD_PARALYZED]
-				&& !p_ptr->timed[TMD_IMAGE] && !p_ptr->word_recall) {
-				disturb(0, 0);
-			}
-		}
-
+	if (rest_is_over()) {
 		/* Resting until sunrise/set */
-		else if (p_ptr->resting == -3) {
-			/* Stop resting */
-			if (!(((turn / 10) * 10) % (10L * TOWN_DAWN))) {
-				if (!outside)
-					msg("It is daybreak.");
-				disturb(0, 0);
-			} else if (!(((turn / 10) * 10) % ((10L * TOWN_DAWN) / 2))) {
-				if (!outside)
-					msg("It is nightfall.");
-				disturb(0, 0);
-			}
+		if ((p_ptr->resting == -3) && !outside) {
+			if (!(((turn / 10) * 10) % (10L * TOWN_DAWN)))
+				msg("It is daybreak.");
+			else
+				msg("It is nightfall.");
 		}
+
+		/* Stop resting */
+		disturb(0, 0);
 	}
 
 	/* Check for "player abort" */
@@ -1524,15 +1591,17 @@ static void process_player(void)
 		if (p_ptr->update)
 			update_stuff(p_ptr);
 
-		/* Redraw stuff (if needed) */
-		if (p_ptr->redraw)
-			redraw_stuff(p_ptr);
+		/* Redraw stuff (if needed), unless it can wait */
+		if (!screen_can_wait()) {
+			if (p_ptr->redraw)
+				redraw_stuff(p_ptr);
 
-		/* Place the cursor on the player */
-		place_cursor();
+			/* Place the cursor on the player */
+			place_cursor();
 
-		/* Refresh (optional) */
-		Term_fresh();
+			/* Refresh (optional) */
+			Term_fresh();
+		}
 
 
 		/* Hack -- Pack Overflow */
@@ -1604,7 +1673,7 @@ static void process_player(void)
 
 			/* Mega hack - complete redraw if big graphics */
 			if ((tile_width > 1) || (tile_height > 1))
-				p_ptr->redraw |= (PR_MAP);
+				p_ptr->redraw |= (PR_PANEL);
 
 		}
 
@@ -1717,45 +1786,91 @@ static void process_player(void)
 	}
 	while (!p_ptr->energy_use && !p_ptr->leaving);
 
-	/* 
-	 * Characters are noisy.
-	 * Use the amount of extra (directed) noise the player has made 
-	 * this turn to calculate the total amount of ambiant noise.
-	 */
-	temp_wakeup_chance =
-		p_ptr->state.base_wakeup_chance + add_wakeup_chance;
+	/* Leave noise and scent behind */
+	player_leaves_traces();
 
-	/* People don't make much noise when resting. */
-	if (p_ptr->resting)
-		temp_wakeup_chance /= 2;
+	PROF_END(PROCESS_PLAYER);
+}
 
-	/* Characters hidden in shadow have almost perfect stealth. */
-	if ((p_ptr->timed[TMD_SSTEALTH]) && (!p_ptr->state.aggravate)) {
-		if (temp_wakeup_chance > 200)
-			temp_wakeup_chance = 200;
-	}
 
 
-	/* Increase noise level if necessary. */
-	if (temp_wakeup_chance > total_wakeup_chance)
-		total_wakeup_chance = temp_wakeup_chance;
+/**
+ * Let the game turns up to the next world turn go by quickly while the
+ * character rests and nothing else is happening.
+ *
+ * Monsters only recover, and the world only changes, every tenth game
+ * turn; in the turns between, a resting character with only quiet monsters
+ * around (see monsters_are_quiet()) just rests, and the monsters just gain
+ * and use their energy.  Those turns are done here without the full round
+ * of processing, and the world turns are left to the main loop, which
+ * will see anything that wakes, arrives or disturbs the character.
+ */
+static void rest_quickly(void)
+{
+	ui_event e;
+	int turns = 0;
 
+	/* Only between world turns */
+	if (!(turn % 10))
+		return;
 
-	/* Update noise flow information */
-	update_noise();
+	/* Only plain resting */
+	if (!p_ptr->resting || p_ptr->leaving || rest_is_over())
+		return;
+	if (p_ptr->timed[TMD_PARALYZED] || (p_ptr->timed[TMD_STUN] >= 100))
+		return;
+	if ((p_ptr->notice & PN_PICKUP) || p_ptr->mana_gain || pack_is_overfull())
+		return;
+	if (p_ptr->timed[TMD_IMAGE] || shimmer_monsters || repair_mflag_mark ||
+		repair_mflag_show)
+		return;
 
-	/* Update scent trail */
-	update_smell();
+	/* Leave any keypress to process_player() */
+	Term_inkey(&e, FALSE, FALSE);
+	if (e.type != EVT_NONE)
+		return;
 
+	/* Nothing may stir */
+	if (!monsters_are_quiet())
+		return;
 
-	/* 
-	 * Reset character vulnerability.  Will be calculated by 
-	 * the first member of an animal pack that has a use for it.
-	 */
-	p_ptr->vulnerability = 0;
+	/* Rest until the next world turn */
+	while (turn % 10) {
+		/* Give the player some energy */
+		p_ptr->energy += extract_energy[p_ptr->state.pspeed];
 
-}
+		/* The player rests */
+		if (p_ptr->energy >= 100) {
+			/* Timed rest */
+			if (p_ptr->resting > 0) {
+				/* Reduce rest count */
+				p_ptr->resting--;
+
+				/* Redraw the state */
+				p_ptr->redraw |= (PR_STATE);
+			}
+
+			/* Take a turn */
+			p_ptr->energy -= 100;
+
+			/* Leave noise and scent behind */
+			player_leaves_traces();
+
+			p_ptr->redraw |= PR_ITEMLIST;
+		}
+
+		/* Next game turn */
+		turn++;
+		turns++;
+
+		/* Timed rest is over */
+		if (!p_ptr->resting)
+			break;
+	}
 
+	/* The monsters do nothing */
+	pass_quiet_turns(turns);
+}
 
 
 byte flicker = 0;
@@ -1831,13 +1946,18 @@ void do_animation(void)
 
 /**
  * This is used when the user is idle to allow for simple animations.
- * Currently the only thing it really does is animate shimmering monsters.
+ * It animates shimmering monsters, and builds the stages the player may go
+ * to next.
  */
 void idle_update(void)
 {
 	if (!character_dungeon)
 		return;
 
+	/* One stage per call, so a key press is never kept waiting long */
+	if (OPT(prepare_stages))
+		prepare_stages();
+
 	if (!OPT(animate_flicker) || (use_graphics != GRAPHICS_NONE))
 		return;
 
@@ -2037,22 +2157,17 @@ static void dungeon(void)
 
 	/* Main loop */
 	while (TRUE) {
-		/* Hack -- Compact the monster list occasionally */
-		if (m_cnt + 32 > z_info->m_max)
+		/* Hack -- Grow the monster list, or compact it if it is full */
+		if ((m_cnt + 32 > m_size) && !grow_m_list())
 			compact_monsters(64);
 
-		/* Hack -- Compress the monster list occasionally */
-		if (m_cnt + 32 < m_max)
-			compact_monsters(0);
-
-
-		/* Hack -- Compact the object list occasionally */
-		if (o_cnt + 32 > z_info->o_max)
+		/* Hack -- Grow the object list, or compact it if it is full */
+		if ((o_cnt + 32 > o_size) && !grow_o_list())
 			compact_objects(64);
 
-		/* Hack -- Compress the object list occasionally */
-		if (o_cnt + 32 < o_max)
-			compact_objects(0);
+		/* Let the quiet turns of a rest go by */
+		if (OPT(quick_rest) && !just_arrived)
+			rest_quickly();
 
 
 	/*** Apply energy ***/
@@ -2080,8 +2195,8 @@ static void dungeon(void)
 						continue;
 
 					/* Give the player at least as much energy */
-					if (m_ptr->energy > p_ptr->energy)
-						p_ptr->energy = m_ptr->energy;
+					if (mon_energy(m_ptr) > p_ptr->energy)
+						p_ptr->energy = mon_energy(m_ptr);
 				}
 			}
 		}
@@ -2098,7 +2213,7 @@ static void dungeon(void)
 			if (!p_ptr->leaving) {
 				/* Mega hack -redraw big graphics - sorry NRM */
 				if ((tile_width > 1) || (tile_height > 1))
-					p_ptr->redraw |= (PR_MAP);
+					p_ptr->redraw |= (PR_PANEL);
 
 				/* Process the player */
 				process_player();
@@ -2113,20 +2228,28 @@ static void dungeon(void)
 		if (p_ptr->update)
 			update_stuff(p_ptr);
 
-		/* Redraw stuff */
-		if (p_ptr->redraw)
-			redraw_stuff(p_ptr);
+		/* Redraw stuff, unless it can wait */
+		if (!screen_can_wait()) {
+			if (p_ptr->redraw)
+				redraw_stuff(p_ptr);
 
-		/* Hack -- Hilight the player */
-		place_cursor();
+			/* Hack -- Hilight the player */
+			place_cursor();
 
-		/* Refresh */
-		Term_fresh();
+			/* Refresh */
+			Term_fresh();
+		}
 
 		/* Handle "leaving" */
 		if (p_ptr->leaving)
 			break;
 
+		/*
+		 * The monsters' and the world's redraws are sent together at the
+		 * end of the game turn, unless the game has to wait for a key first
+		 */
+		event_begin_batch();
+
 		/* Process monsters */
 		process_monsters(0);
 
@@ -2142,18 +2265,14 @@ static void dungeon(void)
 			update_stuff(p_ptr);
 
 		/* Redraw stuff */
-		if (p_ptr->redraw)
+		if (p_ptr->redraw && !screen_can_wait())
 			redraw_stuff(p_ptr);
 
-		/* Hack -- Hilight the player */
-		place_cursor();
-
-		/* Refresh */
-		Term_fresh();
-
 		/* Handle "leaving" */
-		if (p_ptr->leaving)
+		if (p_ptr->leaving) {
+			event_end_batch();
 			break;
+		}
 
 
 		/* Process the world */
@@ -2168,14 +2287,19 @@ static void dungeon(void)
 			update_stuff(p_ptr);
 
 		/* Redraw stuff */
-		if (p_ptr->redraw)
+		if (p_ptr->redraw && !screen_can_wait())
 			redraw_stuff(p_ptr);
 
-		/* Hack -- Hilight the player */
-		place_cursor();
+		event_end_batch();
 
-		/* Refresh */
-		Term_fresh();
+		/* Refresh, unless it can wait */
+		if (!screen_can_wait()) {
+			/* Hack -- Hilight the player */
+			place_cursor();
+
+			/* Refresh */
+			Term_fresh();
+		}
 
 		/* Handle "leaving" */
 		if (p_ptr->leaving)
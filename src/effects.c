@@ -3341,8 +3341,8 @@ bool effect_do(effect_type effect, bool * ident, bool aware, int dir)
 					m_ptr = &m_list[cave_m_idx[y][x]];
 
 					/* Take the energy */
-					p_ptr->energy += m_ptr->energy;
-					m_ptr->energy = 0;
+					p_ptr->energy += mon_energy(m_ptr);
+					mon_energy(m_ptr) = 0;
 				}
 
 			return TRUE;
@@ -3416,7 +3416,7 @@ bool effect_do(effect_type effect, bool * ident, bool aware, int dir)
 							SUMMON_GOLEM);
 
 			/* Hack - make all local golems hostile to the target */
-			for (m_idx = 0; m_idx < z_info->m_max; m_idx++) {
+			for (m_idx = 0; m_idx < m_max; m_idx++) {
 				monster_type *m_ptr = &m_list[m_idx];
 				monster_race *r_ptr = &r_info[m_ptr->r_idx];
 
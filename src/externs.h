@@ -98,8 +98,12 @@ extern bool repair_mflag_show;
 extern bool repair_mflag_mark;
 extern s16b o_max;
 extern s16b o_cnt;
+extern s16b o_free;
+extern s16b o_size;
 extern s16b m_max;
 extern s16b m_cnt;
+extern s16b m_free;
+extern s16b m_size;
 extern s16b trap_max;
 extern s16b trap_cnt;
 extern u16b group_id;
@@ -140,6 +144,9 @@ extern int cost_at_center;
 extern trap_type *trap_list;
 extern object_type *o_list;
 extern monster_type *m_list;
+extern monster_hot m_hot;
+extern region_index mon_regions;
+extern region_index obj_regions;
 extern monster_lore *l_list;
 extern struct store_type *store;
 extern const char *** name_sections;
@@ -269,6 +276,7 @@ extern int get_angle_to_target(int y0, int x0, int y1, int x1, int dir);
 extern void run_step(int dir);
 
 /* randart.c */
+extern void design_random_artifacts(int *granted, int *unspent);
 extern void initialize_random_artifacts(void);
 
 /* score.c */
@@ -21,83 +21,105 @@
 #include "game-event.h"
 
 struct event_handler_entry {
-	struct event_handler_entry *next;
 	game_event_handler *fn;
 	void *user;
 };
 
-struct event_handler_entry *event_handlers[N_GAME_EVENTS];
+/*
+ * The handlers for each event are kept in an array in the order they are to
+ * be called, which is the reverse of the order they were added in.
+ */
+struct event_handler_list {
+	struct event_handler_entry *entries;
+	size_t count;
+	size_t alloc;
+};
+
+static struct event_handler_list event_handlers[N_GAME_EVENTS];
+
+/*
+ * While a batch is open, events without data are only noted and the
+ * handlers for each are called once when the batch is closed.
+ */
+static int batch_depth;
+static bool batch_pending[N_GAME_EVENTS];
+static bool batch_any;
+
+/*
+ * While suspended, events are dropped; nothing the player can see is
+ * happening.
+ */
+static int suspend_depth;
 
 static void game_event_dispatch(game_event_type type,
 								game_event_data * data)
 {
-	struct event_handler_entry *this = event_handlers[type];
+	struct event_handler_list *list = &event_handlers[type];
+	size_t i;
+
+	if (suspend_depth) return;
 
 	/* 
-	 * Send the word out to all interested event handlers.
+	 * Send the word out to all interested event handlers.  The list is
+	 * looked up afresh each time, as handlers may add or remove others.
 	 */
-	while (this) {
+	for (i = 0; i < list->count; i++) {
+		struct event_handler_entry this = list->entries[i];
+
 		/* Call the handler with the relevant data */
-		this->fn(type, data, this->user);
-		this = this->next;
+		this.fn(type, data, this.user);
 	}
 }
 
 void event_add_handler(game_event_type type, game_event_handler * fn,
 					   void *user)
 {
-	struct event_handler_entry *new;
+	struct event_handler_list *list = &event_handlers[type];
 
 	assert(fn != NULL);
 
-	/* Make a new entry */
-	new = mem_alloc(sizeof *new);
-	new->fn = fn;
-	new->user = user;
+	/* Make room */
+	if (list->count == list->alloc) {
+		list->alloc = list->alloc ? list->alloc * 2 : 4;
+		list->entries = mem_realloc(list->entries,
+									list->alloc * sizeof *list->entries);
+	}
 
-	/* Add it to the head of the appropriate list */
-	new->next = event_handlers[type];
-	event_handlers[type] = new;
+	/* Add it to the front of the appropriate list */
+	memmove(list->entries + 1, list->entries,
+			list->count * sizeof *list->entries);
+	list->entries[0].fn = fn;
+	list->entries[0].user = user;
+	list->count++;
 }
 
 void event_remove_handler(game_event_type type, game_event_handler * fn,
 						  void *user)
 {
-	struct event_handler_entry *prev = NULL;
-	struct event_handler_entry *this = event_handlers[type];
+	struct event_handler_list *list = &event_handlers[type];
+	size_t i;
 
 	/* Look for the entry in the list */
-	while (this) {
+	for (i = 0; i < list->count; i++) {
 		/* Check if this is the entry we want to remove */
-		if (this->fn == fn && this->user == user) {
-			if (!prev) {
-				event_handlers[type] = this->next;
-			} else {
-				prev->next = this->next;
-			}
-
-			mem_free(this);
+		if (list->entries[i].fn == fn && list->entries[i].user == user) {
+			list->count--;
+			memmove(list->entries + i, list->entries + i + 1,
+					(list->count - i) * sizeof *list->entries);
 			return;
 		}
-
-		prev = this;
-		this = this->next;
 	}
 }
 
 void event_remove_all_handlers(void)
 {
 	int type;
-	struct event_handler_entry *handler, *next;
 
 	for (type = 0; type < N_GAME_EVENTS; type++) {
-		handler = event_handlers[type];
-		while (handler) {
-			next = handler->next;
-			mem_free(handler);
-			handler = next;
-		}
-		event_handlers[type] = NULL;
+		mem_free(event_handlers[type].entries);
+		event_handlers[type].entries = NULL;
+		event_handlers[type].count = 0;
+		event_handlers[type].alloc = 0;
 	}
 }
 
@@ -122,8 +144,73 @@ void event_remove_handler_set(game_event_type * type, size_t n_types,
 
 
 
+/*
+ * Start a batch of events.  Batches may be nested; the events are only sent
+ * when the outermost one is closed.
+ */
+void event_begin_batch(void)
+{
+	batch_depth++;
+}
+
+/*
+ * Send the events noted so far in the current batch, each once and in the
+ * order they are declared in, so that EVENT_END comes last.
+ */
+void event_flush_batch(void)
+{
+	int type;
+
+	while (batch_any) {
+		batch_any = FALSE;
+
+		for (type = 0; type < N_GAME_EVENTS; type++) {
+			if (!batch_pending[type]) continue;
+
+			batch_pending[type] = FALSE;
+			game_event_dispatch(type, NULL);
+		}
+	}
+}
+
+/*
+ * Close a batch of events, sending them if it was the outermost.
+ */
+void event_end_batch(void)
+{
+	assert(batch_depth > 0);
+
+	if (--batch_depth == 0)
+		event_flush_batch();
+}
+
+/*
+ * Stop sending events, for instance while building a level in the
+ * background.  Suspensions may be nested.
+ */
+void event_suspend(void)
+{
+	suspend_depth++;
+}
+
+void event_resume(void)
+{
+	assert(suspend_depth > 0);
+
+	suspend_depth--;
+}
+
 void event_signal(game_event_type type)
 {
+	if (suspend_depth) return;
+
+	/* Merge with any earlier signal in this batch */
+	if (batch_depth) {
+		batch_pending[type] = TRUE;
+		batch_any = TRUE;
+		return;
+	}
+
 	game_event_dispatch(type, NULL);
 }
 
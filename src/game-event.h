@@ -103,6 +103,13 @@ void event_remove_all_handlers(void);
 void event_add_handler_set(game_event_type *type, size_t n_types, game_event_handler *fn, void *user);
 void event_remove_handler_set(game_event_type *type, size_t n_types, game_event_handler *fn, void *user);
 
+void event_begin_batch(void);
+void event_flush_batch(void);
+void event_end_batch(void);
+
+void event_suspend(void);
+void event_resume(void);
+
 void event_signal_birthpoints(int stats[6], int remaining);
 
 void event_signal_point(game_event_type, int x, int y);
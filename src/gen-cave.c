@@ -1721,7 +1721,7 @@ extern bool build_themed_level(void)
 	p_ptr->themed_level = choice;
 
 	/* Build the themed level. */
-	if (!build_vault(0, 0, 66, 198, t_ptr->text, FALSE, FALSE, 0)) {
+	if (!build_vault(0, 0, 66, 198, &t_ptr->plan, FALSE, FALSE, 0)) {
 		/* Oops.  We're /not/ on a themed level. */
 		p_ptr->themed_level = 0;
 
@@ -1757,7 +1757,8 @@ extern bool build_themed_level(void)
  * We mark grids "icky" to indicate the presence of a vault.
  * We mark grids "temp" to prevent random monsters being placed there.
  *
- * Note that "dun_body" adds about 1100 bytes of memory to the stack.
+ * The generation data "dun" is cleared scratch memory set aside for this
+ * attempt by build_stage().
  */
 extern void cave_gen(void)
 {
@@ -1773,11 +1774,6 @@ extern void cave_gen(void)
 	bool destroyed = FALSE;
 	bool dummy;
 
-	dun_data dun_body;
-
-	/* Global data */
-	dun = &dun_body;
-
 	moria_level = FALSE;
 	underworld = FALSE;
 
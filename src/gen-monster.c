@@ -1050,12 +1050,11 @@ extern void general_monster_restrictions(void)
  * To avoid rebuilding the monster list too often (which can quickly 
  * get expensive), we handle monsters of a specified race separately.
  */
-extern void get_vault_monsters(char racial_symbol[], byte vault_type,
-							   const char *data, int y1, int y2, int x1,
-							   int x2)
+extern void get_vault_monsters(const struct vault_plan *plan, byte vault_type,
+							   int y1, int x1)
 {
-	int i, y, x, temp;
-	const char *t;
+	int i, j, temp;
+	const char *racial_symbol = plan->racial_symbol;
 
 	for (i = 0; racial_symbol[i] != '\0'; i++) {
 		/* Require correct race, allow uniques. */
@@ -1098,13 +1097,13 @@ extern void get_vault_monsters(char racial_symbol[], byte vault_type,
 
 
 		/* Place the monsters */
-		for (t = data, y = y1; y <= y2; y++) {
-			for (x = x1; x <= x2; x++, t++) {
-				if (*t == racial_symbol[i]) {
-					/* Place a monster */
-					place_monster_aux(y, x, get_mon_num_quick(temp), FALSE,
-									  FALSE);
-				}
+		for (j = 0; j < plan->num_monsters; j++) {
+			const struct vault_spot *spot = &plan->monsters[j];
+
+			if (spot->sym == racial_symbol[i]) {
+				/* Place a monster */
+				place_monster_aux(y1 + spot->y, x1 + spot->x,
+								  get_mon_num_quick(temp), FALSE, FALSE);
 			}
 		}
 	}
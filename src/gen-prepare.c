@@ -0,0 +1,692 @@
+/** \file gen-prepare.c
+    \brief Dungeon generation in advance
+
+ * Building the stages the player is likely to go to next while the game
+ * waits for a key, and handing them over when the player gets there.
+ *
+ * Copyright (c) 2026 FAangband contributors
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "angband.h"
+#include "cave.h"
+#include "cmds.h"
+#include "game-event.h"
+#include "generate.h"
+#include "mapmode.h"
+#include "monster.h"
+#include "quest.h"
+#include "trap.h"
+
+
+/*
+ * prepare_stages() looks at the paths and staircases nearest the player,
+ * works out how generate_cave() would be called if the player took each of
+ * them, and builds one of those stages per call.  Each is built into a
+ * level buffer of its own, from a random number stream of its own: the
+ * arrays of the level being played are swapped out for the duration, and
+ * everything else generation touches is put back afterwards, so the game
+ * carries on exactly as if nothing had happened.
+ *
+ * The uniques and artifacts in a prepared stage are given back as soon as
+ * it is built.  take_prepared_stage() claims them again when the player
+ * arrives the way the stage was built for, unless something else has taken
+ * them in the meantime, in which case the stage is generated as usual.  So
+ * are themed levels, which only appear once; an attempt that rolls one is
+ * abandoned.
+ */
+
+/**
+ * The most stages kept ready at once
+ */
+#define PREPARE_MAX	6
+
+/**
+ * The most attempts at a stage before giving up on it
+ */
+#define PREPARE_TRIES	20
+
+/**
+ * Everything about the way the player arrives that generation looks at
+ */
+struct arrival {
+	int stage;
+	int depth;
+	int last_stage;
+	int create_stair;
+	int path_coord;
+
+	int dist;		/* How far the player is from the way there */
+};
+
+enum {
+	PREP_EMPTY = 0,
+	PREP_READY,
+	PREP_FAILED
+};
+
+/**
+ * A level that is not being played, and what it was built for
+ */
+struct level_buf {
+	int state;
+	struct arrival to;
+	u32b stamp;
+
+	/* The level, as in the globals of the same names */
+	grid_256 *info;
+	byte_wid *feat;
+	s16b_wid *o_idx;
+	s16b_wid *m_idx;
+	byte_wid *cost;
+	byte_wid *when;
+
+	object_type *objects;
+	region_index obj_regions;
+	s16b o_max, o_cnt, o_free, o_size;
+
+	monster_type *monsters;
+	monster_hot hot;
+	region_index mon_regions;
+	s16b m_max, m_cnt, m_free, m_size;
+
+	trap_type *traps;
+	s16b trap_max, trap_cnt;
+
+	s16b py, px;
+	int hgt, wid;
+	u16b feeling;
+	s16b rating;
+	u16b group_id;
+	bool moria_level;
+	bool underworld;
+};
+
+static struct level_buf prepared[PREPARE_MAX];
+
+/**
+ * Set while a stage is being built in advance
+ */
+bool stage_preparing = FALSE;
+
+
+#define SWAP(A, B, T) \
+	do { T swap_tmp = (A); (A) = (B); (B) = swap_tmp; } while (0)
+
+/**
+ * Exchange the level in a buffer with the one in the globals.
+ */
+static void swap_level(struct level_buf *b)
+{
+	SWAP(b->info, cave_info, grid_256 *);
+	SWAP(b->feat, cave_feat, byte_wid *);
+	SWAP(b->o_idx, cave_o_idx, s16b_wid *);
+	SWAP(b->m_idx, cave_m_idx, s16b_wid *);
+	SWAP(b->cost, cave_cost, byte_wid *);
+	SWAP(b->when, cave_when, byte_wid *);
+
+	SWAP(b->objects, o_list, object_type *);
+	SWAP(b->obj_regions, obj_regions, region_index);
+	SWAP(b->o_max, o_max, s16b);
+	SWAP(b->o_cnt, o_cnt, s16b);
+	SWAP(b->o_free, o_free, s16b);
+	SWAP(b->o_size, o_size, s16b);
+
+	SWAP(b->monsters, m_list, monster_type *);
+	SWAP(b->hot, m_hot, monster_hot);
+	SWAP(b->mon_regions, mon_regions, region_index);
+	SWAP(b->m_max, m_max, s16b);
+	SWAP(b->m_cnt, m_cnt, s16b);
+	SWAP(b->m_free, m_free, s16b);
+	SWAP(b->m_size, m_size, s16b);
+
+	SWAP(b->traps, trap_list, trap_type *);
+	SWAP(b->trap_max, trap_max, s16b);
+	SWAP(b->trap_cnt, trap_cnt, s16b);
+
+	SWAP(b->py, p_ptr->py, s16b);
+	SWAP(b->px, p_ptr->px, s16b);
+	SWAP(b->hgt, level_hgt, int);
+	SWAP(b->wid, level_wid, int);
+	SWAP(b->feeling, feeling, u16b);
+	SWAP(b->rating, rating, s16b);
+	SWAP(b->group_id, group_id, u16b);
+	SWAP(b->moria_level, moria_level, bool);
+	SWAP(b->underworld, underworld, bool);
+}
+
+/**
+ * Empty the level in the globals without the side effects of
+ * wipe_o_list() and wipe_m_list(), which are for the level being played.
+ */
+static void clear_level(void)
+{
+	memset(cave_info, 0, DUNGEON_HGT * sizeof(grid_256));
+	memset(cave_feat, 0, DUNGEON_HGT * sizeof(byte_wid));
+	memset(cave_o_idx, 0, DUNGEON_HGT * sizeof(s16b_wid));
+	memset(cave_m_idx, 0, DUNGEON_HGT * sizeof(s16b_wid));
+	memset(cave_cost, 0, DUNGEON_HGT * sizeof(byte_wid));
+	memset(cave_when, 0, DUNGEON_HGT * sizeof(byte_wid));
+
+	memset(o_list, 0, o_size * sizeof(object_type));
+	region_clear(&obj_regions, o_size);
+	o_max = 1;
+	o_cnt = 0;
+	o_free = 0;
+
+	memset(m_list, 0, m_size * sizeof(monster_type));
+	clear_monster_hot(&m_hot, m_size);
+	region_clear(&mon_regions, m_size);
+	m_max = 1;
+	m_cnt = 0;
+	m_free = 0;
+
+	memset(trap_list, 0, z_info->l_max * sizeof(trap_type));
+	trap_max = 0;
+	trap_cnt = 0;
+
+	p_ptr->py = p_ptr->px = 0;
+	level_hgt = DUNGEON_HGT;
+	level_wid = DUNGEON_WID;
+}
+
+/**
+ * Give the uniques and artifacts on the level in the globals back to the
+ * rest of the game (claim = FALSE) or take them (claim = TRUE).  When
+ * claiming, return FALSE without changing anything if any of them has been
+ * taken by something else.
+ */
+static bool claim_level(bool claim)
+{
+	int i;
+
+	if (claim) {
+		for (i = 1; i < m_max; i++) {
+			monster_race *r_ptr = &r_info[m_list[i].r_idx];
+
+			if (m_list[i].r_idx && rf_has(r_ptr->flags, RF_UNIQUE)
+				&& (r_ptr->cur_num >= r_ptr->max_num))
+				return (FALSE);
+		}
+
+		for (i = 1; i < o_max; i++)
+			if (o_list[i].k_idx && artifact_p(&o_list[i])
+				&& a_info[o_list[i].name1].created)
+				return (FALSE);
+	}
+
+	num_repro = 0;
+
+	for (i = 1; i < m_max; i++) {
+		monster_race *r_ptr = &r_info[m_list[i].r_idx];
+
+		if (!m_list[i].r_idx)
+			continue;
+
+		if (claim)
+			r_ptr->cur_num++;
+		else
+			r_ptr->cur_num--;
+
+		if (rf_has(r_ptr->flags, RF_MULTIPLY))
+			num_repro++;
+	}
+
+	for (i = 1; i < o_max; i++)
+		if (o_list[i].k_idx && artifact_p(&o_list[i]))
+			a_info[o_list[i].name1].created = claim;
+
+	return (TRUE);
+}
+
+/**
+ * The things outside the level that decide what gets generated, so that
+ * prepared stages can be thrown away when one of them changes.
+ */
+static u32b generation_stamp(void)
+{
+	u32b stamp = (OPT(night_mare) ? 1 : 0) | (OPT(auto_scum) ? 2 : 0);
+	int i;
+
+	for (i = 0; i < MAX_Q_IDX; i++)
+		stamp = stamp * 31 + q_list[i].stage;
+
+	return (stamp);
+}
+
+static bool same_arrival(const struct arrival *a, const struct arrival *b)
+{
+	if ((a->stage != b->stage) || (a->depth != b->depth)
+		|| (a->last_stage != b->last_stage)
+		|| (a->create_stair != b->create_stair))
+		return (FALSE);
+
+	/* Only the wilderness cares where the player left the last stage */
+	if ((stage_map[a->stage][STAGE_TYPE] != CAVE)
+		&& (a->path_coord != b->path_coord))
+		return (FALSE);
+
+	return (TRUE);
+}
+
+
+/**
+ * Work out where taking the path or staircase at (y, x) would lead, the
+ * way do_cmd_go_up() and do_cmd_go_down() do.  Return FALSE for anything
+ * out of the ordinary: portals, ironman, and the stages that rearrange the
+ * stage map when left or entered.
+ */
+static bool predict_arrival(int y, int x, struct arrival *to)
+{
+	int stage = p_ptr->stage;
+	int feat = cave_feat[y][x];
+	feature_type *f_ptr = &f_info[feat];
+	size_t i;
+
+	if (!tf_has(f_ptr->flags, TF_STAIR) && !tf_has(f_ptr->flags, TF_PATH))
+		return (FALSE);
+
+	to->last_stage = stage;
+	to->path_coord = 0;
+
+	if (feat == FEAT_LESS) {
+		to->stage = stage_map[stage][UP];
+		to->create_stair = FEAT_MORE;
+	} else if (feat == FEAT_LESS_SHAFT) {
+		to->stage = stage_map[stage_map[stage][UP]][UP];
+		to->create_stair = FEAT_MORE_SHAFT;
+	} else if (feat == FEAT_MORE) {
+		to->stage = stage_map[stage][DOWN];
+		to->create_stair = FEAT_LESS;
+	} else if (feat == FEAT_MORE_SHAFT) {
+		to->stage = stage_map[stage_map[stage][DOWN]][DOWN];
+		to->create_stair = FEAT_LESS_SHAFT;
+	} else {
+		for (i = 0; i < N_ELEMENTS(path_data); i++)
+			if (path_data[i].path == feat)
+				break;
+		if (i == N_ELEMENTS(path_data))
+			return (FALSE);
+
+		to->stage = stage_map[stage][path_data[i].direction];
+		to->create_stair = path_data[i].return_path;
+		to->path_coord = path_data[i].eastwest ? y : x;
+
+		/* Sliding down into Nan Dungortheb leaves no way back */
+		if (tf_has(f_ptr->flags, TF_DOWNSTAIR)
+			&& (stage_map[to->stage][LOCALITY] == NAN_DUNGORTHEB))
+			return (FALSE);
+	}
+
+	/* Nowhere, or a town, which is quick to build anyway */
+	if (!to->stage || !stage_map[to->stage][DEPTH])
+		return (FALSE);
+
+	/* Going down stairs leaves path_coord undefined */
+	if (tf_has(f_ptr->flags, TF_STAIR) && tf_has(f_ptr->flags, TF_DOWNSTAIR)
+		&& (stage_map[to->stage][STAGE_TYPE] != CAVE))
+		return (FALSE);
+
+	/* Portals in dungeon-only games */
+	if (MAP(DUNGEON) && (stage_map[to->stage][LOCALITY] !=
+						 stage_map[stage][LOCALITY]))
+		return (FALSE);
+
+	/* Stages that change the map */
+	if ((stage_map[to->stage][LOCALITY] == MOUNTAIN_TOP)
+		|| (stage_map[to->stage][LOCALITY] == UNDERWORLD))
+		return (FALSE);
+
+	to->depth = stage_map[to->stage][DEPTH];
+	to->dist = distance(p_ptr->py, p_ptr->px, y, x);
+
+	return (TRUE);
+}
+
+/**
+ * Find the ways off the current stage nearest the player, one for each
+ * destination, nearest first.
+ */
+static int predict_arrivals(struct arrival *to, int max)
+{
+	int y, x, i, n = 0;
+
+	if (MODE(IRONMAN))
+		return (0);
+	if ((stage_map[p_ptr->stage][LOCALITY] == MOUNTAIN_TOP)
+		|| (stage_map[p_ptr->stage][LOCALITY] == UNDERWORLD))
+		return (0);
+
+	for (y = 0; y < level_hgt; y++) {
+		for (x = 0; x < level_wid; x++) {
+			struct arrival a;
+
+			if (!predict_arrival(y, x, &a))
+				continue;
+
+			/* Keep the nearest way to each destination */
+			for (i = 0; i < n; i++)
+				if ((to[i].stage == a.stage)
+					&& (to[i].create_stair == a.create_stair))
+					break;
+
+			if (i < n) {
+				if (a.dist < to[i].dist)
+					to[i] = a;
+			} else if (n < max) {
+				to[n++] = a;
+			} else {
+				/* Replace the furthest, if this is nearer */
+				int j = 0;
+
+				for (i = 1; i < n; i++)
+					if (to[i].dist > to[j].dist)
+						j = i;
+				if (a.dist < to[j].dist)
+					to[j] = a;
+			}
+		}
+	}
+
+	/* Nearest first */
+	for (i = 1; i < n; i++) {
+		struct arrival a = to[i];
+		int j;
+
+		for (j = i; (j > 0) && (to[j - 1].dist > a.dist); j--)
+			to[j] = to[j - 1];
+		to[j] = a;
+	}
+
+	return (n);
+}
+
+
+/**
+ * Build the stage for an arrival into a buffer.
+ */
+static void prepare_stage(struct level_buf *b, const struct arrival *to)
+{
+	static const int quiet[] = {
+		OPT_cheat_peek, OPT_cheat_hear, OPT_cheat_room, OPT_cheat_xtra
+	};
+	bool quiet_opt[N_ELEMENTS(quiet)];
+
+	u32b rand_state[RAND_DEG], rand_i = state_i, rand_z0 = z0,
+		rand_z1 = z1, rand_z2 = z2, rand_value = Rand_value;
+	bool rand_quick = Rand_quick;
+
+	struct arrival from = {
+		p_ptr->stage, p_ptr->depth, p_ptr->last_stage,
+		p_ptr->create_stair, p_ptr->path_coord, 0
+	};
+	byte themed_level = p_ptr->themed_level;
+	bool telepathy = p_ptr->state.telepathy;
+	s16b timed_telepathy = p_ptr->timed[TMD_TELEPATHY];
+	u32b update = p_ptr->update, redraw = p_ptr->redraw;
+	bool dungeon = character_dungeon;
+	s16b old_monster_level = monster_level;
+	s16b old_object_level = object_level;
+	s16b old_num_repro = num_repro;
+	byte old_bones = bones_selector;
+	int old_wild_vaults = wild_vaults;
+
+	size_t i;
+	int num;
+	const char *why = NULL;
+
+	/* Allocate the buffer the first time round */
+	if (!b->feat) {
+		b->info = C_ZNEW(DUNGEON_HGT, grid_256);
+		b->feat = C_ZNEW(DUNGEON_HGT, byte_wid);
+		b->o_idx = C_ZNEW(DUNGEON_HGT, s16b_wid);
+		b->m_idx = C_ZNEW(DUNGEON_HGT, s16b_wid);
+		b->cost = C_ZNEW(DUNGEON_HGT, byte_wid);
+		b->when = C_ZNEW(DUNGEON_HGT, byte_wid);
+		b->objects = C_ZNEW(z_info->o_max, object_type);
+		region_resize(&b->obj_regions, 0, z_info->o_max);
+		b->o_size = z_info->o_max;
+		b->monsters = C_ZNEW(z_info->m_max, monster_type);
+		resize_monster_hot(&b->hot, 0, z_info->m_max);
+		region_resize(&b->mon_regions, 0, z_info->m_max);
+		b->m_size = z_info->m_max;
+		b->traps = C_ZNEW(z_info->l_max, trap_type);
+	}
+
+	b->to = *to;
+	b->stamp = generation_stamp();
+
+	/* Nothing the player could notice may happen */
+	event_suspend();
+	for (i = 0; i < N_ELEMENTS(quiet); i++) {
+		quiet_opt[i] = op_ptr->opt[quiet[i]];
+		op_ptr->opt[quiet[i]] = FALSE;
+	}
+	p_ptr->state.telepathy = FALSE;
+	p_ptr->timed[TMD_TELEPATHY] = 0;
+
+	/* Only one player ghost at a time, and this isn't its level */
+	if (!bones_selector)
+		bones_selector = 1;
+
+	/* A stream of random numbers for this stage */
+	for (i = 0; i < RAND_DEG; i++)
+		rand_state[i] = STATE[i];
+	Rand_quick = FALSE;
+	Rand_state_init(seed_flavor ^ ((u32b) turn * 0x9E3779B1L)
+					^ (to->stage << 20) ^ (to->create_stair << 10)
+					^ to->path_coord);
+
+	/* Arrive */
+	p_ptr->stage = to->stage;
+	p_ptr->depth = to->depth;
+	p_ptr->last_stage = to->last_stage;
+	p_ptr->create_stair = to->create_stair;
+	p_ptr->path_coord = to->path_coord;
+	p_ptr->themed_level = 0;
+	character_dungeon = FALSE;
+	stage_preparing = TRUE;
+
+	/* Build, in the buffer */
+	swap_level(b);
+	clear_level();
+
+	for (num = 0; num < PREPARE_TRIES; num++) {
+		why = build_stage(num);
+		if (!why)
+			break;
+
+		/* Give back whatever was made, and try again */
+		claim_level(FALSE);
+		clear_level();
+
+		if (streq(why, "themed level"))
+			break;
+	}
+
+	if (!why) {
+		/* Hand back the uniques and artifacts until the player arrives */
+		claim_level(FALSE);
+		gen_stat.prepared++;
+		b->state = PREP_READY;
+	} else {
+		b->state = PREP_FAILED;
+	}
+
+	swap_level(b);
+
+	/* Put everything back */
+	stage_preparing = FALSE;
+	character_dungeon = dungeon;
+	p_ptr->stage = from.stage;
+	p_ptr->depth = from.depth;
+	p_ptr->last_stage = from.last_stage;
+	p_ptr->create_stair = from.create_stair;
+	p_ptr->path_coord = from.path_coord;
+	p_ptr->themed_level = themed_level;
+
+	for (i = 0; i < RAND_DEG; i++)
+		STATE[i] = rand_state[i];
+	state_i = rand_i;
+	z0 = rand_z0;
+	z1 = rand_z1;
+	z2 = rand_z2;
+	Rand_value = rand_value;
+	Rand_quick = rand_quick;
+
+	monster_level = old_monster_level;
+	object_level = old_object_level;
+	num_repro = old_num_repro;
+	bones_selector = old_bones;
+	wild_vaults = old_wild_vaults;
+
+	p_ptr->state.telepathy = telepathy;
+	p_ptr->timed[TMD_TELEPATHY] = timed_telepathy;
+	p_ptr->update = update;
+	p_ptr->redraw = redraw;
+	for (i = 0; i < N_ELEMENTS(quiet); i++)
+		op_ptr->opt[quiet[i]] = quiet_opt[i];
+	event_resume();
+}
+
+/**
+ * Build the next stage the player may go to, if it isn't built already.
+ * Returns TRUE if there was anything to do.
+ */
+bool prepare_stages(void)
+{
+	struct arrival to[PREPARE_MAX];
+	int i, j, n;
+
+	if (!OPT(prepare_stages)) {
+		forget_prepared_stages();
+		return (FALSE);
+	}
+
+	if (!character_dungeon || !p_ptr->playing || p_ptr->leaving
+		|| p_ptr->is_dead)
+		return (FALSE);
+
+	n = predict_arrivals(to, PREPARE_MAX);
+
+	/* Find the nearest way off the stage that has nothing built */
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < PREPARE_MAX; j++)
+			if (prepared[j].state && same_arrival(&prepared[j].to, &to[i]))
+				break;
+		if (j == PREPARE_MAX)
+			break;
+	}
+	if (i == n)
+		return (FALSE);
+
+	/* Find room for it, in preference to anywhere no longer likely */
+	for (j = 0; j < PREPARE_MAX; j++)
+		if (!prepared[j].state)
+			break;
+
+	if (j == PREPARE_MAX) {
+		for (j = 0; j < PREPARE_MAX; j++) {
+			int k;
+
+			for (k = 0; k < n; k++)
+				if (same_arrival(&prepared[j].to, &to[k]))
+					break;
+			if (k == n)
+				break;
+		}
+	}
+	if (j == PREPARE_MAX)
+		return (FALSE);
+
+	prepare_stage(&prepared[j], &to[i]);
+
+	return (TRUE);
+}
+
+/**
+ * If a stage has been built for the way the player is arriving, make it
+ * the current level and return TRUE.
+ */
+bool take_prepared_stage(void)
+{
+	struct arrival here = {
+		p_ptr->stage, p_ptr->depth, p_ptr->last_stage,
+		p_ptr->create_stair, p_ptr->path_coord, 0
+	};
+	int i;
+
+	if (!OPT(prepare_stages))
+		return (FALSE);
+
+	for (i = 0; i < PREPARE_MAX; i++) {
+		struct level_buf *b = &prepared[i];
+
+		if ((b->state != PREP_READY) || !same_arrival(&b->to, &here))
+			continue;
+
+		/* Not if anything that went into it has changed */
+		if (b->stamp != generation_stamp())
+			break;
+
+		swap_level(b);
+		if (!claim_level(TRUE)) {
+			swap_level(b);
+			break;
+		}
+
+		/* The buffer now holds the old level, wiped */
+		b->state = PREP_EMPTY;
+		gen_stat.prepared_used++;
+		return (TRUE);
+	}
+
+	return (FALSE);
+}
+
+/**
+ * Throw away every stage built in advance.
+ */
+void forget_prepared_stages(void)
+{
+	int i;
+
+	for (i = 0; i < PREPARE_MAX; i++)
+		prepared[i].state = PREP_EMPTY;
+}
+
+/**
+ * Free the level buffers.
+ */
+void free_prepared_stages(void)
+{
+	int i;
+
+	for (i = 0; i < PREPARE_MAX; i++) {
+		struct level_buf *b = &prepared[i];
+
+		FREE(b->info);
+		FREE(b->feat);
+		FREE(b->o_idx);
+		FREE(b->m_idx);
+		FREE(b->cost);
+		FREE(b->when);
+		FREE(b->objects);
+		region_resize(&b->obj_regions, b->o_size, 0);
+		FREE(b->monsters);
+		resize_monster_hot(&b->hot, b->m_size, 0);
+		region_resize(&b->mon_regions, b->m_size, 0);
+		FREE(b->traps);
+		b->state = PREP_EMPTY;
+	}
+}
@@ -2355,22 +2355,195 @@ static bool build_type6(void)
 
 
 
+/**
+ * Symbols that get an object, a trap or a random monster once the terrain
+ * of a vault is down.
+ */
+static const char vault_item_symbols[] = "1234567890~$]|=\"!?_-,";
+
+/**
+ * Compile the text of a vault, which is hgt rows of wid symbols, into the
+ * lists build_vault() works from.
+ */
+extern void compile_vault(struct vault *v_ptr, int hgt, int wid)
+{
+	struct vault_plan *plan = &v_ptr->plan;
+	size_t len = v_ptr->text ? strlen(v_ptr->text) : 0;
+	int y, x, races = 0;
+
+	free_vault_plan(v_ptr);
+
+	plan->runs = C_ZNEW(hgt * wid, struct vault_run);
+	plan->items = C_ZNEW(hgt * wid, struct vault_spot);
+	plan->monsters = C_ZNEW(hgt * wid, struct vault_spot);
+
+	for (y = 0; y < hgt; y++) {
+		for (x = 0; x < wid; x++) {
+			size_t i = (size_t) y * wid + x;
+			char sym = (i < len) ? v_ptr->text[i] : ' ';
+			struct vault_run *run = NULL;
+
+			/* Hack -- skip "non-grids" */
+			if (sym == ' ')
+				continue;
+
+			/* Extend the last run, or start a new one */
+			if (plan->num_runs)
+				run = &plan->runs[plan->num_runs - 1];
+			if (run && (run->y == y) && (run->x + run->len == x)
+				&& (run->sym == sym) && (run->len < 255)) {
+				run->len++;
+			} else {
+				run = &plan->runs[plan->num_runs++];
+				run->y = y;
+				run->x = x;
+				run->len = 1;
+				run->sym = sym;
+			}
+
+			/* Most alphabetic characters signify monster races. */
+			if (isalpha((unsigned char) sym) && (sym != 'x') && (sym != 'X')) {
+				struct vault_spot *spot =
+					&plan->monsters[plan->num_monsters++];
+
+				spot->y = y;
+				spot->x = x;
+				spot->sym = sym;
+
+				/* Note each symbol the first time it is seen */
+				if (!strchr(plan->racial_symbol, sym) && (races < 30))
+					plan->racial_symbol[races++] = sym;
+			}
+
+			/* Otherwise it may be an object or trap */
+			else if (strchr(vault_item_symbols, sym)) {
+				struct vault_spot *spot = &plan->items[plan->num_items++];
+
+				spot->y = y;
+				spot->x = x;
+				spot->sym = sym;
+			}
+		}
+	}
+
+	/* Give back what wasn't needed */
+	plan->runs = mem_realloc(plan->runs,
+							 (plan->num_runs + 1) * sizeof(struct vault_run));
+	plan->items = mem_realloc(plan->items,
+							  (plan->num_items + 1) * sizeof(struct vault_spot));
+	plan->monsters = mem_realloc(plan->monsters, (plan->num_monsters + 1)
+								 * sizeof(struct vault_spot));
+}
+
+/**
+ * Free the compiled form of a vault.
+ */
+extern void free_vault_plan(struct vault *v_ptr)
+{
+	struct vault_plan *plan = &v_ptr->plan;
+
+	FREE(plan->runs);
+	FREE(plan->items);
+	FREE(plan->monsters);
+	WIPE(plan, struct vault_plan);
+}
+
+
+/*
+ * Vaults by type and depth: the indexes of the vaults of type typ that can
+ * appear at depth are vault_index[vault_index_start[typ * MAX_DEPTH +
+ * depth]] onwards, up to the start of the next entry.
+ */
+static s16b *vault_index;
+static int *vault_index_start;
+static int vault_index_types;
+
+/**
+ * Build the index of vaults by type and depth.
+ */
+extern void init_vault_index(void)
+{
+	int i, typ, depth, n = 0;
+
+	free_vault_index();
+
+	for (i = 0; i < z_info->v_max; i++)
+		if (v_info[i].typ >= vault_index_types)
+			vault_index_types = v_info[i].typ + 1;
+
+	vault_index_start = C_ZNEW(vault_index_types * MAX_DEPTH + 1, int);
+
+	/* Count the vaults for each type and depth */
+	for (i = 0; i < z_info->v_max; i++) {
+		struct vault *v_ptr = &v_info[i];
+
+		for (depth = v_ptr->min_lev;
+			 (depth <= v_ptr->max_lev) && (depth < MAX_DEPTH); depth++)
+			vault_index_start[v_ptr->typ * MAX_DEPTH + depth + 1]++;
+	}
+
+	/* Turn the counts into starting points */
+	for (i = 1; i <= vault_index_types * MAX_DEPTH; i++)
+		vault_index_start[i] += vault_index_start[i - 1];
+
+	vault_index = C_ZNEW(MAX(vault_index_start[vault_index_types * MAX_DEPTH],
+							 1), s16b);
+
+	/* Fill in the vaults, in order, for each type and depth */
+	for (typ = 0; typ < vault_index_types; typ++) {
+		for (depth = 0; depth < MAX_DEPTH; depth++) {
+			for (i = 0; i < z_info->v_max; i++) {
+				struct vault *v_ptr = &v_info[i];
+
+				if ((v_ptr->typ == typ) && (v_ptr->min_lev <= depth)
+					&& (v_ptr->max_lev >= depth))
+					vault_index[n++] = i;
+			}
+		}
+	}
+}
+
+extern void free_vault_index(void)
+{
+	FREE(vault_index);
+	FREE(vault_index_start);
+	vault_index_types = 0;
+}
+
+/**
+ * Pick a random vault of the given type that can appear at the given depth,
+ * or return NULL if there are none.
+ */
+extern struct vault *random_vault(int typ, int depth)
+{
+	int first, num;
+
+	if ((typ < 0) || (typ >= vault_index_types) || (depth < 0)
+		|| (depth >= MAX_DEPTH))
+		return (NULL);
+
+	first = vault_index_start[typ * MAX_DEPTH + depth];
+	num = vault_index_start[typ * MAX_DEPTH + depth + 1] - first;
+	if (!num)
+		return (NULL);
+
+	return (&v_info[vault_index[first + randint0(num)]]);
+}
+
+
 /**
  * Hack -- fill in "vault" rooms and themed levels
  */
 extern bool build_vault(int y0, int x0, int ymax, int xmax,
-						const char *data, bool light, bool icky,
+						const struct vault_plan *plan, bool light, bool icky,
 						byte vault_type)
 {
-	int x, y;
+	int x, y, i;
 	int y1, x1, y2, x2, panic_y = 0, panic_x = 0;
-	int temp, races = 0;
+	int temp, floor;
 
 	bool placed = FALSE;
 
-	const char *t;
-	char racial_symbol[30] = "";
-
 	/* Bail if no vaults allowed on this stage */
 	if (no_vault())
 		return (FALSE);
@@ -2407,22 +2580,23 @@ extern bool build_vault(int y0, int x0, int ymax, int xmax,
 		general_monster_restrictions();
 
 
+	/* Vaults are laid on floor or grass */
+	if (((stage_map[p_ptr->stage][STAGE_TYPE] == CAVE)
+		 || (stage_map[p_ptr->stage][STAGE_TYPE] == DESERT)
+		 || (stage_map[p_ptr->stage][STAGE_TYPE] == MOUNTAIN))
+		&& (p_ptr->themed_level != THEME_SLAIN))
+		floor = FEAT_FLOOR;
+	else
+		floor = FEAT_GRASS;
+
 	/* Place dungeon features and objects */
-	for (t = data, y = y1; y <= y2; y++) {
-		for (x = x1; x <= x2; x++, t++) {
-			/* Hack -- skip "non-grids" */
-			if (*t == ' ') {
-				continue;
-			}
+	for (i = 0; i < plan->num_runs; i++) {
+		const struct vault_run *run = &plan->runs[i];
 
+		y = y1 + run->y;
+		for (x = x1 + run->x; x < x1 + run->x + run->len; x++) {
 			/* Lay down a floor or grass */
-			if (((stage_map[p_ptr->stage][STAGE_TYPE] == CAVE)
-				 || (stage_map[p_ptr->stage][STAGE_TYPE] == DESERT)
-				 || (stage_map[p_ptr->stage][STAGE_TYPE] == MOUNTAIN))
-				&& (p_ptr->themed_level != THEME_SLAIN))
-				cave_set_feat(y, x, FEAT_FLOOR);
-			else
-				cave_set_feat(y, x, FEAT_GRASS);
+			cave_set_feat(y, x, floor);
 
 			/* Part of a vault.  Can be lit.  May be "icky". */
 			if (icky) {
@@ -2434,7 +2608,7 @@ extern bool build_vault(int y0, int x0, int ymax, int xmax,
 				sqinfo_on(cave_info[y][x], SQUARE_GLOW);
 
 			/* Analyze the grid */
-			switch (*t) {
+			switch (run->sym) {
 				/* Granite wall (outer) or outer edge of dungeon level or web. */
 			case '%':
 				{
@@ -2632,355 +2806,342 @@ extern bool build_vault(int y0, int x0, int ymax, int xmax,
 		}
 	}
 
-	/* Place dungeon monsters and objects */
-	for (t = data, y = y1; y <= y2; y++) {
-		for (x = x1; x <= x2; x++, t++) {
-			/* Hack -- skip "non-grids" */
-			if (*t == ' ')
-				continue;
+	/* Place dungeon objects, traps and random monsters */
+	for (i = 0; i < plan->num_items; i++) {
+		const struct vault_spot *spot = &plan->items[i];
 
-			/* Most alphabetic characters signify monster races. */
-			if (isalpha(*t) && (*t != 'x') && (*t != 'X')) {
-				/* If the symbol is not yet stored, ... */
-				if (!strchr(racial_symbol, *t)) {
-					/* ... store it for later processing. */
-					if (races < 30)
-						racial_symbol[races++] = *t;
-				}
-			}
+		y = y1 + spot->y;
+		x = x1 + spot->x;
 
-			/* Otherwise, analyze the symbol */
-			else
-				switch (*t) {
-					/* An ordinary monster, object (sometimes good), or trap. */
-				case '1':
-					{
-						int rand = randint0(4);
-
-						if (rand < 2) {
-							place_monster(y, x, TRUE, TRUE, FALSE);
-						}
+		switch (spot->sym) {
+			/* An ordinary monster, object (sometimes good), or trap. */
+		case '1':
+			{
+				int rand = randint0(4);
 
-						/* I had not intended this function to create
-						 * guaranteed "good" quality objects, but perhaps it's
-						 * better that it does at least sometimes. */
-						else if (rand == 2) {
-							if (randint0(8) == 0)
-								place_object(y, x, TRUE, FALSE, FALSE,
-											 ORIGIN_VAULT);
-							else
-								place_object(y, x, FALSE, FALSE, FALSE,
-											 ORIGIN_VAULT);
+				if (rand < 2) {
+					place_monster(y, x, TRUE, TRUE, FALSE);
+				}
 
-						} else {
-							place_trap(y, x, -1, p_ptr->depth);
-						}
-						break;
-					}
-					/* Slightly out of depth monster. */
-				case '2':
-					{
-						monster_level = p_ptr->depth + 3;
-						place_monster(y, x, TRUE, TRUE, FALSE);
-						monster_level = p_ptr->depth;
-						break;
-					}
-					/* Slightly out of depth object. */
-				case '3':
-					{
-						object_level = p_ptr->depth + 3;
-						place_object(y, x, FALSE, FALSE, FALSE,
-									 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
-						break;
-					}
-					/* Monster and/or object */
-				case '4':
-					{
-						if (randint0(100) < 50) {
-							monster_level = p_ptr->depth + 4;
-							place_monster(y, x, TRUE, TRUE, FALSE);
-							monster_level = p_ptr->depth;
-						}
-						if (randint0(100) < 50) {
-							object_level = p_ptr->depth + 4;
-							place_object(y, x, FALSE, FALSE, FALSE,
-										 ORIGIN_VAULT);
-							object_level = p_ptr->depth;
-						}
-						break;
-					}
-					/* Out of depth object. */
-				case '5':
-					{
-						object_level = p_ptr->depth + 7;
-						place_object(y, x, FALSE, FALSE, FALSE,
+				/* I had not intended this function to create
+				 * guaranteed "good" quality objects, but perhaps it's
+				 * better that it does at least sometimes. */
+				else if (rand == 2) {
+					if (randint0(8) == 0)
+						place_object(y, x, TRUE, FALSE, FALSE,
 									 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
-						break;
-					}
-					/* Out of depth monster. */
-				case '6':
-					{
-						monster_level = p_ptr->depth + 7;
-						place_monster(y, x, TRUE, TRUE, FALSE);
-						monster_level = p_ptr->depth;
-						break;
-					}
-					/* Very out of depth object. */
-				case '7':
-					{
-						object_level = p_ptr->depth + 15;
+					else
 						place_object(y, x, FALSE, FALSE, FALSE,
 									 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
-						break;
-					}
-					/* Very out of depth monster. */
-				case '8':
-					{
-						monster_level = p_ptr->depth + 20;
-						place_monster(y, x, TRUE, TRUE, FALSE);
-						monster_level = p_ptr->depth;
-						break;
-					}
-					/* Meaner monster, plus "good" (or better) object */
-				case '9':
-					{
-						monster_level = p_ptr->depth + 15;
-						place_monster(y, x, TRUE, TRUE, FALSE);
-						monster_level = p_ptr->depth;
-						object_level = p_ptr->depth + 5;
-						place_object(y, x, TRUE, FALSE, FALSE,
-									 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
-						break;
-					}
 
-					/* Nasty monster and "great" (or better) object */
-				case '0':
-					{
-						monster_level = p_ptr->depth + 30;
-						place_monster(y, x, TRUE, TRUE, FALSE);
-						monster_level = p_ptr->depth;
-						object_level = p_ptr->depth + 15;
-						place_object(y, x, TRUE, TRUE, FALSE,
-									 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
-						break;
-					}
+				} else {
+					place_trap(y, x, -1, p_ptr->depth);
+				}
+				break;
+			}
+			/* Slightly out of depth monster. */
+		case '2':
+			{
+				monster_level = p_ptr->depth + 3;
+				place_monster(y, x, TRUE, TRUE, FALSE);
+				monster_level = p_ptr->depth;
+				break;
+			}
+			/* Slightly out of depth object. */
+		case '3':
+			{
+				object_level = p_ptr->depth + 3;
+				place_object(y, x, FALSE, FALSE, FALSE,
+							 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
+				break;
+			}
+			/* Monster and/or object */
+		case '4':
+			{
+				if (randint0(100) < 50) {
+					monster_level = p_ptr->depth + 4;
+					place_monster(y, x, TRUE, TRUE, FALSE);
+					monster_level = p_ptr->depth;
+				}
+				if (randint0(100) < 50) {
+					object_level = p_ptr->depth + 4;
+					place_object(y, x, FALSE, FALSE, FALSE,
+								 ORIGIN_VAULT);
+					object_level = p_ptr->depth;
+				}
+				break;
+			}
+			/* Out of depth object. */
+		case '5':
+			{
+				object_level = p_ptr->depth + 7;
+				place_object(y, x, FALSE, FALSE, FALSE,
+							 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
+				break;
+			}
+			/* Out of depth monster. */
+		case '6':
+			{
+				monster_level = p_ptr->depth + 7;
+				place_monster(y, x, TRUE, TRUE, FALSE);
+				monster_level = p_ptr->depth;
+				break;
+			}
+			/* Very out of depth object. */
+		case '7':
+			{
+				object_level = p_ptr->depth + 15;
+				place_object(y, x, FALSE, FALSE, FALSE,
+							 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
+				break;
+			}
+			/* Very out of depth monster. */
+		case '8':
+			{
+				monster_level = p_ptr->depth + 20;
+				place_monster(y, x, TRUE, TRUE, FALSE);
+				monster_level = p_ptr->depth;
+				break;
+			}
+			/* Meaner monster, plus "good" (or better) object */
+		case '9':
+			{
+				monster_level = p_ptr->depth + 15;
+				place_monster(y, x, TRUE, TRUE, FALSE);
+				monster_level = p_ptr->depth;
+				object_level = p_ptr->depth + 5;
+				place_object(y, x, TRUE, FALSE, FALSE,
+							 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
+				break;
+			}
 
-					/* A chest. */
-				case '~':
-					{
-						required_tval = TV_CHEST;
+			/* Nasty monster and "great" (or better) object */
+		case '0':
+			{
+				monster_level = p_ptr->depth + 30;
+				place_monster(y, x, TRUE, TRUE, FALSE);
+				monster_level = p_ptr->depth;
+				object_level = p_ptr->depth + 15;
+				place_object(y, x, TRUE, TRUE, FALSE,
+							 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
+				break;
+			}
 
-						object_level = p_ptr->depth + 5;
-						place_object(y, x, FALSE, FALSE, TRUE,
-									 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
+			/* A chest. */
+		case '~':
+			{
+				required_tval = TV_CHEST;
 
-						required_tval = 0;
+				object_level = p_ptr->depth + 5;
+				place_object(y, x, FALSE, FALSE, TRUE,
+							 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
 
-						break;
-					}
-					/* Treasure. */
-				case '$':
-					{
-						place_gold(y, x);
-						break;
-					}
-					/* Armour. */
-				case ']':
-					{
-						object_level = p_ptr->depth + 3;
+				required_tval = 0;
 
-						if (randint1(3) == 1)
-							temp = randint1(9);
-						else
-							temp = randint1(8);
-
-						if (temp == 1)
-							required_tval = TV_BOOTS;
-						else if (temp == 2)
-							required_tval = TV_GLOVES;
-						else if (temp == 3)
-							required_tval = TV_HELM;
-						else if (temp == 4)
-							required_tval = TV_CROWN;
-						else if (temp == 5)
-							required_tval = TV_SHIELD;
-						else if (temp == 6)
-							required_tval = TV_CLOAK;
-						else if (temp == 7)
-							required_tval = TV_SOFT_ARMOR;
-						else if (temp == 8)
-							required_tval = TV_HARD_ARMOR;
-						else
-							required_tval = TV_DRAG_ARMOR;
+				break;
+			}
+			/* Treasure. */
+		case '$':
+			{
+				place_gold(y, x);
+				break;
+			}
+			/* Armour. */
+		case ']':
+			{
+				object_level = p_ptr->depth + 3;
 
-						place_object(y, x, TRUE, FALSE, TRUE,
-									 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
+				if (randint1(3) == 1)
+					temp = randint1(9);
+				else
+					temp = randint1(8);
+
+				if (temp == 1)
+					required_tval = TV_BOOTS;
+				else if (temp == 2)
+					required_tval = TV_GLOVES;
+				else if (temp == 3)
+					required_tval = TV_HELM;
+				else if (temp == 4)
+					required_tval = TV_CROWN;
+				else if (temp == 5)
+					required_tval = TV_SHIELD;
+				else if (temp == 6)
+					required_tval = TV_CLOAK;
+				else if (temp == 7)
+					required_tval = TV_SOFT_ARMOR;
+				else if (temp == 8)
+					required_tval = TV_HARD_ARMOR;
+				else
+					required_tval = TV_DRAG_ARMOR;
 
-						required_tval = 0;
+				place_object(y, x, TRUE, FALSE, TRUE,
+							 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
 
-						break;
-					}
-					/* Weapon. */
-				case '|':
-					{
-						object_level = p_ptr->depth + 3;
-
-						temp = randint1(4);
-
-						if (temp == 1)
-							required_tval = TV_SWORD;
-						else if (temp == 2)
-							required_tval = TV_POLEARM;
-						else if (temp == 3)
-							required_tval = TV_HAFTED;
-						else if (temp == 4)
-							required_tval = TV_BOW;
-
-						place_object(y, x, TRUE, FALSE, TRUE,
-									 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
+				required_tval = 0;
 
-						required_tval = 0;
+				break;
+			}
+			/* Weapon. */
+		case '|':
+			{
+				object_level = p_ptr->depth + 3;
+
+				temp = randint1(4);
+
+				if (temp == 1)
+					required_tval = TV_SWORD;
+				else if (temp == 2)
+					required_tval = TV_POLEARM;
+				else if (temp == 3)
+					required_tval = TV_HAFTED;
+				else if (temp == 4)
+					required_tval = TV_BOW;
+
+				place_object(y, x, TRUE, FALSE, TRUE,
+							 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
 
-						break;
-					}
-					/* Ring. */
-				case '=':
-					{
-						required_tval = TV_RING;
-
-						object_level = p_ptr->depth + 3;
-						if (randint1(4) == 1)
-							place_object(y, x, TRUE, FALSE, TRUE,
-										 ORIGIN_VAULT);
-						else
-							place_object(y, x, FALSE, FALSE, TRUE,
-										 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
+				required_tval = 0;
 
-						required_tval = 0;
+				break;
+			}
+			/* Ring. */
+		case '=':
+			{
+				required_tval = TV_RING;
+
+				object_level = p_ptr->depth + 3;
+				if (randint1(4) == 1)
+					place_object(y, x, TRUE, FALSE, TRUE,
+								 ORIGIN_VAULT);
+				else
+					place_object(y, x, FALSE, FALSE, TRUE,
+								 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
 
-						break;
-					}
-					/* Amulet. */
-				case '"':
-					{
-						required_tval = TV_AMULET;
-
-						object_level = p_ptr->depth + 3;
-						if (randint1(4) == 1)
-							place_object(y, x, TRUE, FALSE, TRUE,
-										 ORIGIN_VAULT);
-						else
-							place_object(y, x, FALSE, FALSE, TRUE,
-										 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
+				required_tval = 0;
 
-						required_tval = 0;
+				break;
+			}
+			/* Amulet. */
+		case '"':
+			{
+				required_tval = TV_AMULET;
+
+				object_level = p_ptr->depth + 3;
+				if (randint1(4) == 1)
+					place_object(y, x, TRUE, FALSE, TRUE,
+								 ORIGIN_VAULT);
+				else
+					place_object(y, x, FALSE, FALSE, TRUE,
+								 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
 
-						break;
-					}
-					/* Potion. */
-				case '!':
-					{
-						required_tval = TV_POTION;
-
-						object_level = p_ptr->depth + 3;
-						if (randint1(4) == 1)
-							place_object(y, x, TRUE, FALSE, TRUE,
-										 ORIGIN_VAULT);
-						else
-							place_object(y, x, FALSE, FALSE, TRUE,
-										 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
+				required_tval = 0;
 
-						required_tval = 0;
+				break;
+			}
+			/* Potion. */
+		case '!':
+			{
+				required_tval = TV_POTION;
+
+				object_level = p_ptr->depth + 3;
+				if (randint1(4) == 1)
+					place_object(y, x, TRUE, FALSE, TRUE,
+								 ORIGIN_VAULT);
+				else
+					place_object(y, x, FALSE, FALSE, TRUE,
+								 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
 
-						break;
-					}
-					/* Scroll. */
-				case '?':
-					{
-						required_tval = TV_SCROLL;
-
-						object_level = p_ptr->depth + 3;
-						if (randint1(4) == 1)
-							place_object(y, x, TRUE, FALSE, TRUE,
-										 ORIGIN_VAULT);
-						else
-							place_object(y, x, FALSE, FALSE, TRUE,
-										 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
+				required_tval = 0;
 
-						required_tval = 0;
+				break;
+			}
+			/* Scroll. */
+		case '?':
+			{
+				required_tval = TV_SCROLL;
+
+				object_level = p_ptr->depth + 3;
+				if (randint1(4) == 1)
+					place_object(y, x, TRUE, FALSE, TRUE,
+								 ORIGIN_VAULT);
+				else
+					place_object(y, x, FALSE, FALSE, TRUE,
+								 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
 
-						break;
-					}
-					/* Staff. */
-				case '_':
-					{
-						required_tval = TV_STAFF;
-
-						object_level = p_ptr->depth + 3;
-						if (randint1(4) == 1)
-							place_object(y, x, TRUE, FALSE, TRUE,
-										 ORIGIN_VAULT);
-						else
-							place_object(y, x, FALSE, FALSE, TRUE,
-										 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
+				required_tval = 0;
 
-						required_tval = 0;
+				break;
+			}
+			/* Staff. */
+		case '_':
+			{
+				required_tval = TV_STAFF;
+
+				object_level = p_ptr->depth + 3;
+				if (randint1(4) == 1)
+					place_object(y, x, TRUE, FALSE, TRUE,
+								 ORIGIN_VAULT);
+				else
+					place_object(y, x, FALSE, FALSE, TRUE,
+								 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
 
-						break;
-					}
-					/* Wand or rod. */
-				case '-':
-					{
-						if (randint0(100) < 50)
-							required_tval = TV_WAND;
-						else
-							required_tval = TV_ROD;
+				required_tval = 0;
 
-						object_level = p_ptr->depth + 3;
-						if (randint1(4) == 1)
-							place_object(y, x, TRUE, FALSE, TRUE,
-										 ORIGIN_VAULT);
-						else
-							place_object(y, x, FALSE, FALSE, TRUE,
-										 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
+				break;
+			}
+			/* Wand or rod. */
+		case '-':
+			{
+				if (randint0(100) < 50)
+					required_tval = TV_WAND;
+				else
+					required_tval = TV_ROD;
 
-						required_tval = 0;
+				object_level = p_ptr->depth + 3;
+				if (randint1(4) == 1)
+					place_object(y, x, TRUE, FALSE, TRUE,
+								 ORIGIN_VAULT);
+				else
+					place_object(y, x, FALSE, FALSE, TRUE,
+								 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
 
-						break;
-					}
-					/* Food or mushroom. */
-				case ',':
-					{
-						required_tval = TV_FOOD;
+				required_tval = 0;
 
-						object_level = p_ptr->depth + 3;
-						place_object(y, x, FALSE, FALSE, TRUE,
-									 ORIGIN_VAULT);
-						object_level = p_ptr->depth;
+				break;
+			}
+			/* Food or mushroom. */
+		case ',':
+			{
+				required_tval = TV_FOOD;
+
+				object_level = p_ptr->depth + 3;
+				place_object(y, x, FALSE, FALSE, TRUE,
+							 ORIGIN_VAULT);
+				object_level = p_ptr->depth;
 
-						required_tval = 0;
+				required_tval = 0;
 
-						break;
-					}
-				}
+				break;
+			}
 		}
 	}
 
-	get_vault_monsters(racial_symbol, vault_type, data, y1, y2, x1, x2);
+	get_vault_monsters(plan, vault_type, y1, x1);
 
 	/* Ensure that the player is always placed in a themed level. */
 	if ((p_ptr->themed_level) && (!placed)) {
@@ -2990,6 +3151,9 @@ extern bool build_vault(int y0, int x0, int ymax, int xmax,
 			player_place(panic_y, panic_x);
 	}
 
+	if (!p_ptr->themed_level)
+		gen_stat.vaults++;
+
 	/* Success. */
 	return (TRUE);
 }
@@ -3001,29 +3165,15 @@ extern bool build_vault(int y0, int x0, int ymax, int xmax,
 static bool build_type7(void)
 {
 	struct vault *v_ptr;
-	int i, y, x;
-	int *v_idx = malloc(z_info->v_max * sizeof(*v_idx));
-	int v_cnt = 0;
-
-	/* Examine each vault */
-	for (i = 0; i < z_info->v_max; i++) {
-		/* Access the vault */
-		v_ptr = &v_info[i];
-
-		/* Accept each interesting room that is acceptable for this depth. */
-		if ((v_ptr->typ == 7) && (v_ptr->min_lev <= p_ptr->depth)
-			&& (v_ptr->max_lev >= p_ptr->depth)) {
-			v_idx[v_cnt++] = i;
-		}
-	}
+	int y, x;
 
-	/* Access a random vault record */
-	v_ptr = &v_info[v_idx[randint0(v_cnt)]];
+	/* Pick an interesting room that is acceptable for this depth */
+	v_ptr = random_vault(7, p_ptr->depth);
+	if (!v_ptr)
+		return (FALSE);
 
-	if (!find_space(&y, &x, v_ptr->hgt, v_ptr->wid)) {
-		free(v_idx);
+	if (!find_space(&y, &x, v_ptr->hgt, v_ptr->wid))
 		return (FALSE);
-	}
 
 	/* Boost the rating */
 	rating += v_ptr->rat;
@@ -3031,13 +3181,9 @@ static bool build_type7(void)
 
 	/* Build the vault (sometimes lit, not icky, type 7) */
 	if (!build_vault
-		(y, x, v_ptr->hgt, v_ptr->wid, v_ptr->text,
-		 (p_ptr->depth < randint0(37)), FALSE, 7)) {
-		free(v_idx);
+		(y, x, v_ptr->hgt, v_ptr->wid, &v_ptr->plan,
+		 (p_ptr->depth < randint0(37)), FALSE, 7))
 		return (FALSE);
-	}
-
-	free(v_idx);
 
 	return (TRUE);
 }
@@ -3048,31 +3194,17 @@ static bool build_type7(void)
 static bool build_type8(void)
 {
 	struct vault *v_ptr;
-	int i, y, x;
-	int *v_idx = malloc(z_info->v_max * sizeof(*v_idx));
-	int v_cnt = 0;
-
-	/* Examine each vault */
-	for (i = 0; i < z_info->v_max; i++) {
-		/* Access the vault */
-		v_ptr = &v_info[i];
-
-		/* Accept each lesser vault that is acceptable for this depth. */
-		if ((v_ptr->typ == 8) && (v_ptr->min_lev <= p_ptr->depth)
-			&& (v_ptr->max_lev >= p_ptr->depth)) {
-			v_idx[v_cnt++] = i;
-		}
-	}
+	int y, x;
 
-	/* Access a random vault record */
-	v_ptr = &v_info[v_idx[randint0(v_cnt)]];
+	/* Pick a lesser vault that is acceptable for this depth */
+	v_ptr = random_vault(8, p_ptr->depth);
+	if (!v_ptr)
+		return (FALSE);
 
 
 	/* Find and reserve some space in the dungeon.  Get center of room. */
-	if (!find_space(&y, &x, v_ptr->hgt, v_ptr->wid)) {
-		free(v_idx);
+	if (!find_space(&y, &x, v_ptr->hgt, v_ptr->wid))
 		return (FALSE);
-	}
 
 
 	/* Message */
@@ -3084,12 +3216,8 @@ static bool build_type8(void)
 
 	/* Build the vault (never lit, icky, type 8) */
 	if (!build_vault
-		(y, x, v_ptr->hgt, v_ptr->wid, v_ptr->text, FALSE, TRUE, 8)) {
-		free(v_idx);
+		(y, x, v_ptr->hgt, v_ptr->wid, &v_ptr->plan, FALSE, TRUE, 8))
 		return (FALSE);
-	}
-
-	free(v_idx);
 
 	return (TRUE);
 }
@@ -3102,31 +3230,17 @@ static bool build_type8(void)
 static bool build_type9(void)
 {
 	struct vault *v_ptr;
-	int i, y, x;
-	int *v_idx = malloc(z_info->v_max * sizeof(int));
-	int v_cnt = 0;
-
-	/* Examine each vault */
-	for (i = 0; i < z_info->v_max; i++) {
-		/* Access the vault */
-		v_ptr = &v_info[i];
-
-		/* Accept each greater vault that is acceptable for this depth. */
-		if ((v_ptr->typ == 9) && (v_ptr->min_lev <= p_ptr->depth)
-			&& (v_ptr->max_lev >= p_ptr->depth)) {
-			v_idx[v_cnt++] = i;
-		}
-	}
+	int y, x;
 
-	/* Access a random vault record */
-	v_ptr = &v_info[v_idx[randint0(v_cnt)]];
+	/* Pick a greater vault that is acceptable for this depth */
+	v_ptr = random_vault(9, p_ptr->depth);
+	if (!v_ptr)
+		return (FALSE);
 
 
 	/* Find and reserve some space in the dungeon.  Get center of room. */
-	if (!find_space(&y, &x, v_ptr->hgt, v_ptr->wid)) {
-		free(v_idx);
+	if (!find_space(&y, &x, v_ptr->hgt, v_ptr->wid))
 		return (FALSE);
-	}
 
 
 	/* Message */
@@ -3138,12 +3252,8 @@ static bool build_type9(void)
 
 	/* Build the vault (never lit, icky, type 9) */
 	if (!build_vault
-		(y, x, v_ptr->hgt, v_ptr->wid, v_ptr->text, FALSE, TRUE, 9)) {
-		free(v_idx);
+		(y, x, v_ptr->hgt, v_ptr->wid, &v_ptr->plan, FALSE, TRUE, 9))
 		return (FALSE);
-	}
-
-	free(v_idx);
 
 	return (TRUE);
 }
@@ -645,9 +645,7 @@ static int make_formation(int y, int x, int base_feat1, int base_feat2,
 	/* Need to make some "wilderness vaults" */
 	if (wild_vaults) {
 		struct vault *v_ptr;
-		int n, yy, xx;
-		int v_cnt = 0;
-		int *v_idx = malloc(z_info->v_max * sizeof(*v_idx));
+		int yy, xx;
 
 		bool good_place = TRUE;
 
@@ -655,30 +653,16 @@ static int make_formation(int y, int x, int base_feat1, int base_feat2,
 		if (randint0(100 - p_ptr->depth) < 9)
 			wild_type += 1;
 
-		/* Examine each "vault" */
-		for (n = 0; n < z_info->v_max; n++) {
-			/* Access the "vault" */
-			v_ptr = &v_info[n];
-
-			/* Accept each "vault" that is acceptable for this location */
-			if ((v_ptr->typ == wild_type)
-				&& (v_ptr->min_lev <= p_ptr->depth)
-				&& (v_ptr->max_lev >= p_ptr->depth)) {
-				v_idx[v_cnt++] = n;
-			}
-		}
+		/* Pick a "vault" that is acceptable for this location */
+		v_ptr = random_vault(wild_type, p_ptr->depth);
 
 		/* If none appropriate, cancel vaults for this level */
-		if (!v_cnt) {
+		if (!v_ptr) {
 			wild_vaults = 0;
 			free(all_feat);
-			free(v_idx);
 			return (0);
 		}
 
-		/* Access a random "vault" record */
-		v_ptr = &v_info[v_idx[randint0(v_cnt)]];
-
 		/* Check to see if it will fit here (only avoid edges) */
 		if ((in_bounds_fully(y - v_ptr->hgt / 2, x - v_ptr->wid / 2))
 			&& (in_bounds_fully(y + v_ptr->hgt / 2, x + v_ptr->wid / 2))) {
@@ -698,10 +682,9 @@ static int make_formation(int y, int x, int base_feat1, int base_feat2,
 		if (good_place) {
 			/* Build the "vault" (never lit, icky) */
 			if (!build_vault
-				(y, x, v_ptr->hgt, v_ptr->wid, v_ptr->text, FALSE,
+				(y, x, v_ptr->hgt, v_ptr->wid, &v_ptr->plan, FALSE,
 				 TRUE, wild_type)) {
 				free(all_feat);
-				free(v_idx);
 				return (0);
 			}
 
@@ -717,7 +700,6 @@ static int make_formation(int y, int x, int base_feat1, int base_feat2,
 
 			/* Takes up some space */
 			free(all_feat);
-			free(v_idx);
 			return (v_ptr->hgt * v_ptr->wid);
 		}
 	}
@@ -1881,31 +1863,15 @@ bool place_web(int type)
 {
 	struct vault *v_ptr;
 	int i, y, x = DUNGEON_WID / 2, cy, cx;
-	int *v_idx = malloc(z_info->v_max * sizeof(v_idx));
-	int v_cnt = 0;
 
 	bool no_good = FALSE;
 
-	/* Examine each web */
-	for (i = 0; i < z_info->v_max; i++) {
-		/* Access the web */
-		v_ptr = &v_info[i];
-
-		/* Accept each web that is acceptable for this depth. */
-		if ((v_ptr->typ == type) && (v_ptr->min_lev <= p_ptr->depth)
-			&& (v_ptr->max_lev >= p_ptr->depth)) {
-			v_idx[v_cnt++] = i;
-		}
-	}
+	/* Pick a web that is acceptable for this depth */
+	v_ptr = random_vault(type, p_ptr->depth);
 
 	/* None to be found */
-	if (v_cnt == 0) {
-		free(v_idx);
+	if (!v_ptr)
 		return (FALSE);
-	}
-
-	/* Access a random vault record */
-	v_ptr = &v_info[v_idx[randint0(v_cnt)]];
 
 	/* Look for somewhere to put it */
 	for (i = 0; i < 25; i++) {
@@ -1932,10 +1898,8 @@ bool place_web(int type)
 	}
 
 	/* Give up if we couldn't find anywhere */
-	if (no_good) {
-		free(v_idx);
+	if (no_good)
 		return (FALSE);
-	}
 
 	/* Boost the rating */
 	rating += v_ptr->rat;
@@ -1943,13 +1907,10 @@ bool place_web(int type)
 
 	/* Build the vault (never lit, not icky unless full size) */
 	if (!build_vault
-		(y, x, v_ptr->hgt, v_ptr->wid, v_ptr->text, FALSE,
-		 (type == 13), type)) {
-		free(v_idx);
+		(y, x, v_ptr->hgt, v_ptr->wid, &v_ptr->plan, FALSE,
+		 (type == 13), type))
 		return (FALSE);
-	}
 
-	free(v_idx);
 	return (TRUE);
 }
 
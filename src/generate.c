@@ -60,6 +60,65 @@ bool underworld;
  */
 int wild_vaults;
 
+/**
+ * Running totals of generation attempts and outcomes
+ */
+gen_stats gen_stat;
+
+/**
+ * Scratch memory for the generation attempt in progress.  Everything in it
+ * is given back at once when the next attempt starts.
+ */
+static struct {
+	byte *base;
+	size_t used;
+} gen_arena;
+
+
+/**
+ * Set aside size bytes of cleared scratch memory, which last until the end
+ * of the current generation attempt.
+ */
+void *gen_alloc(size_t size)
+{
+	byte *mem;
+
+	/* Keep everything aligned for any type */
+	size = (size + 7) & ~((size_t) 7);
+
+	if (gen_arena.used + size > GEN_ARENA_SIZE)
+		quit("Out of level generation scratch memory!");
+
+	mem = gen_arena.base + gen_arena.used;
+	gen_arena.used += size;
+	memset(mem, 0, size);
+
+	if (gen_arena.used > gen_stat.scratch_peak)
+		gen_stat.scratch_peak = gen_arena.used;
+
+	return mem;
+}
+
+/**
+ * Give back all the scratch memory of the last generation attempt
+ */
+static void reset_gen_arena(void)
+{
+	if (!gen_arena.base)
+		gen_arena.base = mem_alloc(GEN_ARENA_SIZE);
+
+	gen_arena.used = 0;
+}
+
+/**
+ * Free the scratch memory, at shutdown
+ */
+void free_gen_arena(void)
+{
+	FREE(gen_arena.base);
+	gen_arena.used = 0;
+}
+
 
 /**
  * Builds a store at a given pseudo-location
@@ -468,259 +527,307 @@ static void clear_cave(void)
 
 
 /**
- * Generate a random dungeon level
- *
- * Hack -- regenerate any "overflow" levels
- *
- * Hack -- allow auto-scumming via a gameplay option.
- *
- * Note that this function resets flow data and grid flags directly.
- * Note that this function does not reset features, monsters, or objects.  
- * Features are left to the town and dungeon generation functions, and 
- * wipe_m_list() and wipe_o_list() handle monsters and objects.
+ * Make one attempt at building the current stage, returning why it was
+ * rejected, or NULL if it will do.  num counts the attempts made so far.
  */
-void generate_cave(void)
+const char *build_stage(int num)
 {
-	int y, x, num;
+	int y, x;
+	int max = 2;
+	bool themed;
+	const char *why = NULL;
 
-	level_hgt = DUNGEON_HGT;
-	level_wid = DUNGEON_WID;
-	clear_cave();
+	gen_stat.attempts++;
 
-	/* The dungeon is not ready */
-	character_dungeon = FALSE;
+	/* Nothing from the last attempt is needed */
+	reset_gen_arena();
 
-	/* Don't know feeling yet */
-	do_feeling = FALSE;
+	/* Fresh generation data, also seen by themed levels */
+	dun = gen_alloc(sizeof(dun_data));
 
-	/* Assume level is not themed. */
-	p_ptr->themed_level = 0;
+	/* Reset monsters and objects */
+	o_max = 1;
+	m_max = 1;
 
-	/* Generate */
-	for (num = 0; TRUE; num++) {
-		int max = 2;
-		bool okay = TRUE;
-		const char *why = NULL;
 
-		/* Reset monsters and objects */
-		o_max = 1;
-		m_max = 1;
+	/* Clear flags and flow information. */
+	for (y = 0; y < DUNGEON_HGT; y++) {
+		for (x = 0; x < DUNGEON_WID; x++) {
+			/* No flags */
+			sqinfo_wipe(cave_info[y][x]);
 
+			/* No flow */
+			cave_cost[y][x] = 0;
+			cave_when[y][x] = 0;
 
-		/* Clear flags and flow information. */
-		for (y = 0; y < DUNGEON_HGT; y++) {
-			for (x = 0; x < DUNGEON_WID; x++) {
-				/* No flags */
-				sqinfo_wipe(cave_info[y][x]);
+		}
+	}
 
-				/* No flow */
-				cave_cost[y][x] = 0;
-				cave_when[y][x] = 0;
 
-			}
-		}
+	/* Mega-Hack -- no player in dungeon yet */
+	cave_m_idx[p_ptr->py][p_ptr->px] = 0;
+	p_ptr->px = p_ptr->py = 0;
 
+	/* Reset the monster generation level */
+	monster_level = p_ptr->depth;
 
-		/* Mega-Hack -- no player in dungeon yet */
-		cave_m_idx[p_ptr->py][p_ptr->px] = 0;
-		p_ptr->px = p_ptr->py = 0;
+	/* Reset the object generation level */
+	object_level = p_ptr->depth;
 
-		/* Reset the monster generation level */
-		monster_level = p_ptr->depth;
+	/* Nothing good here yet */
+	rating = 0;
 
-		/* Reset the object generation level */
-		object_level = p_ptr->depth;
+	/* Only group is the player */
+	group_id = 1;
 
-		/* Nothing good here yet */
-		rating = 0;
+	/* Set the number of wilderness "vaults" */
+	wild_vaults = 0;
+	if (OPT(night_mare))
+		max += 2;
 
-		/* Only group is the player */
-		group_id = 1;
+	if (p_ptr->depth > 10)
+		wild_vaults += randint0(max);
+	if (p_ptr->depth > 20)
+		wild_vaults += randint0(max);
+	if (p_ptr->depth > 30)
+		wild_vaults += randint0(max);
+	if (p_ptr->depth > 40)
+		wild_vaults += randint0(max);
 
-		/* Set the number of wilderness "vaults" */
+	if (no_vault())
 		wild_vaults = 0;
-		if (OPT(night_mare))
-			max += 2;
-
-		if (p_ptr->depth > 10)
-			wild_vaults += randint0(max);
-		if (p_ptr->depth > 20)
-			wild_vaults += randint0(max);
-		if (p_ptr->depth > 30)
-			wild_vaults += randint0(max);
-		if (p_ptr->depth > 40)
-			wild_vaults += randint0(max);
-
-		if (no_vault())
-			wild_vaults = 0;
-
-		/* Build the town */
-		if (!p_ptr->depth) {
-			/* Make a town */
-			town_gen();
+
+	/* Build the town */
+	if (!p_ptr->depth) {
+		/* Make a town */
+		town_gen();
+	}
+
+	/* Not town */
+	else {
+		/* It is possible for levels to be themed. */
+		themed = (randint0(THEMED_LEVEL_CHANCE) == 0);
+
+		/* Themed levels only appear once, so are never built in advance */
+		if (themed && stage_preparing)
+			return ("themed level");
+
+		if (themed && build_themed_level()) {
+			/* Message. */
+			if (OPT(cheat_room))
+				msg("Themed level");
 		}
 
-		/* Not town */
+		/* Build a real stage */
 		else {
-			/* It is possible for levels to be themed. */
-			if ((randint0(THEMED_LEVEL_CHANCE) == 0)
-				&& build_themed_level()) {
-				/* Message. */
-				if (OPT(cheat_room))
-					msg("Themed level");
-			}
+			switch (stage_map[p_ptr->stage][STAGE_TYPE]) {
+			case CAVE:
+				{
+					cave_gen();
+					break;
+				}
 
-			/* Build a real stage */
-			else {
-				switch (stage_map[p_ptr->stage][STAGE_TYPE]) {
-				case CAVE:
-					{
-						cave_gen();
-						break;
-					}
-
-				case VALLEY:
-					{
-						valley_gen();
-						break;
-					}
-
-				case MOUNTAIN:
-					{
-						mtn_gen();
-						break;
-					}
-
-				case MOUNTAINTOP:
-					{
-						mtntop_gen();
-						break;
-					}
-
-				case FOREST:
-					{
-						forest_gen();
-						break;
-					}
-
-				case SWAMP:
-					{
-						swamp_gen();
-						break;
-					}
-
-				case RIVER:
-					{
-						river_gen();
-						break;
-					}
-
-				case DESERT:
-					{
-						desert_gen();
-						break;
-					}
-
-				case PLAIN:
-					{
-						plain_gen();
-					}
+			case VALLEY:
+				{
+					valley_gen();
+					break;
 				}
-			}
-		}
 
-		okay = TRUE;
-
-
-		/* Extract the feeling */
-		if (rating > 50 + p_ptr->depth)
-			feeling = 2;
-		else if (rating > 40 + 4 * p_ptr->depth / 5)
-			feeling = 3;
-		else if (rating > 30 + 3 * p_ptr->depth / 5)
-			feeling = 4;
-		else if (rating > 20 + 2 * p_ptr->depth / 5)
-			feeling = 5;
-		else if (rating > 15 + 1 * p_ptr->depth / 3)
-			feeling = 6;
-		else if (rating > 10 + 1 * p_ptr->depth / 5)
-			feeling = 7;
-		else if (rating > 5 + 1 * p_ptr->depth / 10)
-			feeling = 8;
-		else if (rating > 0)
-			feeling = 9;
-		else
-			feeling = 10;
-
-		/* Hack -- no feeling in the town */
-		if (!p_ptr->depth)
-			feeling = 0;
-
-
-		/* Prevent object over-flow */
-		if (o_max >= z_info->o_max) {
-			/* Message */
-			why = "too many objects";
+			case MOUNTAIN:
+				{
+					mtn_gen();
+					break;
+				}
 
-			/* Message */
-			okay = FALSE;
-		}
+			case MOUNTAINTOP:
+				{
+					mtntop_gen();
+					break;
+				}
 
-		/* Prevent monster over-flow */
-		if (m_max >= z_info->m_max) {
-			/* Message */
-			why = "too many monsters";
+			case FOREST:
+				{
+					forest_gen();
+					break;
+				}
 
-			/* Message */
-			okay = FALSE;
-		}
+			case SWAMP:
+				{
+					swamp_gen();
+					break;
+				}
+
+			case RIVER:
+				{
+					river_gen();
+					break;
+				}
 
-		/* Mega-Hack -- "auto-scum" */
-		if (OPT(auto_scum) && (num < 100) && !(p_ptr->themed_level)) {
-			int fudge = (no_vault()? 3 : 0);
-
-			/* Require "goodness" */
-			if ((feeling > fudge + 9)
-				|| ((p_ptr->depth >= 5) && (feeling > fudge + 8))
-				|| ((p_ptr->depth >= 10) && (feeling > fudge + 7))
-				|| ((p_ptr->depth >= 20) && (feeling > fudge + 6))) {
-				/* Give message to cheaters */
-				if (OPT(cheat_room) || OPT(cheat_hear) || OPT(cheat_peek)
-					|| OPT(cheat_xtra)) {
-					/* Message */
-					why = "boring level";
+			case DESERT:
+				{
+					desert_gen();
+					break;
 				}
 
-				/* Try again */
-				okay = FALSE;
+			case PLAIN:
+				{
+					plain_gen();
+				}
 			}
 		}
+	}
+
+
+	/* Extract the feeling */
+	if (rating > 50 + p_ptr->depth)
+		feeling = 2;
+	else if (rating > 40 + 4 * p_ptr->depth / 5)
+		feeling = 3;
+	else if (rating > 30 + 3 * p_ptr->depth / 5)
+		feeling = 4;
+	else if (rating > 20 + 2 * p_ptr->depth / 5)
+		feeling = 5;
+	else if (rating > 15 + 1 * p_ptr->depth / 3)
+		feeling = 6;
+	else if (rating > 10 + 1 * p_ptr->depth / 5)
+		feeling = 7;
+	else if (rating > 5 + 1 * p_ptr->depth / 10)
+		feeling = 8;
+	else if (rating > 0)
+		feeling = 9;
+	else
+		feeling = 10;
+
+	/* Hack -- no feeling in the town */
+	if (!p_ptr->depth)
+		feeling = 0;
 
+
+	/* Prevent object over-flow */
+	if (o_max >= z_info->o_max) {
 		/* Message */
-		if ((OPT(cheat_room)) && (why))
-			msg("Generation restarted (%s)", why);
+		why = "too many objects";
+		gen_stat.too_many_objects++;
+	}
 
-		/* Accept */
-		if (okay)
-			break;
+	/* Prevent monster over-flow */
+	if (m_max >= z_info->m_max) {
+		/* Message */
+		why = "too many monsters";
+		gen_stat.too_many_monsters++;
+	}
 
-		/* Wipe the objects */
-		wipe_o_list();
+	/* Mega-Hack -- "auto-scum" */
+	if (OPT(auto_scum) && (num < 100) && !(p_ptr->themed_level)) {
+		int fudge = (no_vault()? 3 : 0);
 
-		/* Wipe the monsters */
-		wipe_m_list();
+		/* Require "goodness" */
+		if ((feeling > fudge + 9)
+			|| ((p_ptr->depth >= 5) && (feeling > fudge + 8))
+			|| ((p_ptr->depth >= 10) && (feeling > fudge + 7))
+			|| ((p_ptr->depth >= 20) && (feeling > fudge + 6))) {
+			/* Message */
+			why = "boring level";
+			gen_stat.boring++;
+		}
+	}
+
+	/* Count what is about to be thrown away */
+	if (why) {
+		gen_stat.discarded_objects += o_max - 1;
+		gen_stat.discarded_monsters += m_max - 1;
+	}
+
+	return (why);
+}
 
-		/* A themed level was generated */
-		if (p_ptr->themed_level) {
-			/* Allow the themed level to be generated again */
-			p_ptr->themed_level_appeared &=
-				~(1L << (p_ptr->themed_level - 1));
 
-			/* This is not a themed level */
-			p_ptr->themed_level = 0;
+/**
+ * Generate a random dungeon level
+ *
+ * Hack -- regenerate any "overflow" levels
+ *
+ * Hack -- allow auto-scumming via a gameplay option.
+ *
+ * Use a stage built in advance by prepare_stages() if there is one for
+ * the way the player arrived.
+ *
+ * Each attempt takes its scratch data from gen_alloc(), and gives it all
+ * back when the next one starts; cheat_room reports how much the accepted
+ * attempt used and what the rejected ones threw away.
+ *
+ * Note that this function resets flow data and grid flags directly.
+ * Note that this function does not reset features, monsters, or objects.  
+ * Features are left to the town and dungeon generation functions, and 
+ * wipe_m_list() and wipe_o_list() handle monsters and objects.
+ */
+void generate_cave(void)
+{
+	int num;
+	u32b objects = gen_stat.discarded_objects;
+	u32b monsters = gen_stat.discarded_monsters;
+
+	PROF_BEGIN(GENERATE_CAVE);
+
+	level_hgt = DUNGEON_HGT;
+	level_wid = DUNGEON_WID;
+	clear_cave();
+
+	/* The dungeon is not ready */
+	character_dungeon = FALSE;
+
+	/* Don't know feeling yet */
+	do_feeling = FALSE;
+
+	/* Assume level is not themed. */
+	p_ptr->themed_level = 0;
+
+	/* Use a stage built in advance, or generate one */
+	if (!take_prepared_stage()) {
+		for (num = 0; TRUE; num++) {
+			const char *why = build_stage(num);
+
+			/* Message */
+			if ((OPT(cheat_room)) && (why))
+				msg("Generation restarted (%s)", why);
+
+			/* Accept */
+			if (!why) {
+				gen_stat.levels++;
+				if (p_ptr->themed_level)
+					gen_stat.themed++;
+
+				/* Message */
+				if (OPT(cheat_room))
+					msg("Level built in %d attempt%s, with %lu bytes of "
+						"scratch (%lu objects, %lu monsters discarded).",
+						num + 1, PLURAL(num + 1),
+						(unsigned long)gen_arena.used,
+						(unsigned long)(gen_stat.discarded_objects - objects),
+						(unsigned long)(gen_stat.discarded_monsters - monsters));
+				break;
+			}
+
+			/* Wipe the objects */
+			wipe_o_list();
+
+			/* Wipe the monsters */
+			wipe_m_list();
+
+			/* A themed level was generated */
+			if (p_ptr->themed_level) {
+				/* Allow the themed level to be generated again */
+				p_ptr->themed_level_appeared &=
+					~(1L << (p_ptr->themed_level - 1));
+
+				/* This is not a themed level */
+				p_ptr->themed_level = 0;
+			}
 		}
 	}
 
+	/* Anything else built in advance is for somewhere else */
+	forget_prepared_stages();
 
 	/* The dungeon is ready */
 	character_dungeon = TRUE;
@@ -739,4 +846,6 @@ void generate_cave(void)
 	number_of_thefts_on_level = 0;
 	for (num = 0; num < RUNE_TAIL; num++)
 		num_runes_on_level[num] = 0;
+
+	PROF_END(GENERATE_CAVE);
 }
@@ -68,6 +68,37 @@ struct room_profile {
 };
 #endif
 
+/**
+ * A run of grids in one row of a vault that share a symbol
+ */
+struct vault_run {
+    byte y, x;		/**< First grid, from the vault's top left corner */
+    byte len;		/**< Number of grids */
+    char sym;		/**< Symbol from the vault text */
+};
+
+/**
+ * A single grid of a vault that gets something placed on it
+ */
+struct vault_spot {
+    byte y, x;		/**< Grid, from the vault's top left corner */
+    char sym;		/**< Symbol from the vault text */
+};
+
+/**
+ * A vault's text compiled for build_vault(), in the order it lays the
+ * vault out: terrain, then objects and traps, then monsters by race.
+ */
+struct vault_plan {
+    struct vault_run *runs;		/**< Every grid that isn't blank */
+    struct vault_spot *items;		/**< Objects, traps and random monsters */
+    struct vault_spot *monsters;	/**< Monsters chosen by symbol */
+    u16b num_runs;
+    u16b num_items;
+    u16b num_monsters;
+    char racial_symbol[31];		/**< Monster symbols, as first seen */
+};
+
 /**
  * Information about "vault generation"
  */
@@ -87,6 +118,8 @@ struct vault {
 
     byte min_lev;	/**< Minimum allowable level, if specified. */
     byte max_lev;	/**< Maximum allowable level, if specified. */
+
+    struct vault_plan plan;	/**< The text, compiled */
 };
 
 
@@ -197,6 +230,11 @@ struct vault {
 #define TUNN_MAX	300
 #define STAIR_MAX	30
 
+/**
+ * Bytes of scratch memory available to one generation attempt
+ */
+#define GEN_ARENA_SIZE	8192
+
 /**
  * Normal levels get at least 16 monsters
  */
@@ -278,7 +316,35 @@ struct dun_data {
     int room_map[MAX_ROOMS_ROW][MAX_ROOMS_COL];
 };
 
+/**
+ * Running totals kept by generate_cave(), for benchmarking
+ */
+typedef struct gen_stats gen_stats;
+
+struct gen_stats {
+    u32b levels;		/* Levels accepted */
+    u32b themed;		/* Themed levels accepted */
+    u32b attempts;		/* Attempts, including rejected ones */
+
+    /* Rejected attempts, by reason */
+    u32b too_many_objects;
+    u32b too_many_monsters;
+    u32b boring;
+
+    u32b vaults;		/* Vaults laid out, in any attempt */
+
+    /* Thrown away with rejected attempts */
+    u32b discarded_objects;
+    u32b discarded_monsters;
+
+    u32b scratch_peak;		/* Most scratch bytes one attempt used */
+
+    u32b prepared;		/* Stages built in advance */
+    u32b prepared_used;		/* Arrivals that found their stage built */
+};
+
 extern dun_data *dun;
+extern gen_stats gen_stat;
 extern bool moria_level;
 extern bool underworld;
 extern int wild_vaults;
@@ -291,8 +357,8 @@ extern void get_chamber_monsters(int y1, int x1, int y2, int x2);
 extern void spread_monsters(char symbol, int depth, int num, int y0, int x0,
 			    int dy, int dx);
 extern void general_monster_restrictions(void);
-extern void get_vault_monsters(char racial_symbol[], byte vault_type, const char *data,
-			       int y1, int y2, int x1, int x2);
+extern void get_vault_monsters(const struct vault_plan *plan, byte vault_type,
+			       int y1, int x1);
 
 extern void correct_dir(int *row_dir, int *col_dir, int y1, int x1, int y2,
 			int x2);
@@ -306,8 +372,14 @@ extern void destroy_level(bool new_level);
 extern bool passable(int feat);
 extern bool generate_starburst_room(int y1, int x1, int y2, int x2, bool light,
 				    int feat, bool special_ok);
-extern bool build_vault(int y0, int x0, int ymax, int xmax, const char *data,
-			bool light, bool icky, byte vault_type);
+extern void compile_vault(struct vault *v_ptr, int hgt, int wid);
+extern void free_vault_plan(struct vault *v_ptr);
+extern void init_vault_index(void);
+extern void free_vault_index(void);
+extern struct vault *random_vault(int typ, int depth);
+extern bool build_vault(int y0, int x0, int ymax, int xmax,
+			const struct vault_plan *plan, bool light, bool icky,
+			byte vault_type);
 extern bool room_build(int room_type);
 
 int next_to_walls(int y, int x);
@@ -329,7 +401,17 @@ extern void desert_gen(void);
 extern void river_gen(void);
 extern void valley_gen(void);
 extern void cave_gen(void);
+extern void *gen_alloc(size_t size);
+extern void free_gen_arena(void);
+extern const char *build_stage(int num);
 extern void generate_cave(void);
 
+/* gen-prepare.c */
+extern bool stage_preparing;
+extern bool prepare_stages(void);
+extern bool take_prepared_stage(void);
+extern void forget_prepared_stages(void);
+extern void free_prepared_stages(void);
+
 #endif /* !GENERATE_H */
 
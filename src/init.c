@@ -3117,10 +3117,12 @@ static errr finish_parse_v(struct parser *p)
 	for (v = parser_priv(p); v; v = v->next) {
 		if (v->vidx >= z_info->v_max)
 			continue;
-;
 		memcpy(&v_info[v->vidx], v, sizeof(*v));
+		compile_vault(&v_info[v->vidx], v->hgt, v->wid);
 	}
 
+	init_vault_index();
+
 	v = parser_priv(p);
 	while (v) {
 		n = v->next;
@@ -3138,8 +3140,10 @@ static void cleanup_v(void)
 	for (idx = 0; idx < z_info->v_max; idx++) {
 		mem_free(v_info[idx].name);
 		mem_free(v_info[idx].text);
+		free_vault_plan(&v_info[idx]);
 	}
 	mem_free(v_info);
+	free_vault_index();
 }
 
 struct file_parser v_parser = {
@@ -3207,6 +3211,7 @@ static errr finish_parse_t(struct parser *p)
 		if (v->vidx >= z_info->t_max)
 			continue;
 		memcpy(&t_info[v->vidx], v, sizeof(*v));
+		compile_vault(&t_info[v->vidx], DUNGEON_HGT, DUNGEON_WID);
 	}
 
 	v = parser_priv(p);
@@ -3227,6 +3232,7 @@ static void cleanup_t(void)
 		mem_free(t_info[idx].name);
 		mem_free(t_info[idx].text);
 		mem_free(t_info[idx].message);
+		free_vault_plan(&t_info[idx]);
 	}
 	mem_free(t_info);
 }
@@ -4118,9 +4124,14 @@ static errr init_other(void)
 
 	/* Objects */
 	o_list = C_ZNEW(z_info->o_max, object_type);
+	region_resize(&obj_regions, 0, z_info->o_max);
+	o_size = z_info->o_max;
 
 	/* Monsters */
 	m_list = C_ZNEW(z_info->m_max, monster_type);
+	resize_monster_hot(&m_hot, 0, z_info->m_max);
+	region_resize(&mon_regions, 0, z_info->m_max);
+	m_size = z_info->m_max;
 
 	/* Traps */
 	trap_list = C_ZNEW(z_info->l_max, trap_type);
@@ -4825,6 +4836,11 @@ bool init_angband(void)
 	if (init_alloc())
 		quit("Cannot initialize alloc stuff");
 
+	/* Initialize the monster spell lists */
+	event_signal_string(EVENT_INITSTATUS,
+						"Initializing arrays... (monster spells)");
+	init_race_spells();
+
 	/*** Load default user pref files ***/
 
 	/* Initialize feature info */
@@ -4882,6 +4898,9 @@ void cleanup_angband(void)
 	FREE(alloc_ego_table);
 	FREE(alloc_race_table);
 
+	/* Free the monster spell lists */
+	free_race_spells();
+
 	event_remove_all_handlers();
 
 	if (store) {
@@ -4914,7 +4933,15 @@ void cleanup_angband(void)
 	FREE(l_list);
 	FREE(trap_list);
 	FREE(m_list);
+	resize_monster_hot(&m_hot, m_size, 0);
+	region_resize(&mon_regions, m_size, 0);
 	FREE(o_list);
+	region_resize(&obj_regions, o_size, 0);
+	free_mon_vis();
+	free_obj_seen();
+	free_prepared_stages();
+	free_gen_arena();
+	free_display_map();
 
 	/* Flow arrays */
 	FREE(cave_when);
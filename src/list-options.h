@@ -39,10 +39,16 @@ OP(hp_changes_colour,     "Player colour indicates low hit points",
 INTERFACE, TRUE)
 OP(auto_more,             "Automatically clear '-more-' prompts",
 INTERFACE, FALSE)
+OP(fast_forward,          "Skip screen updates while running or resting",
+INTERFACE, FALSE)
 OP(auto_scum,             "Auto-scum for good levels",
 GAMEPLAY, FALSE)
 OP(night_mare,            "Generate more pits and vaults",
 GAMEPLAY, FALSE)
+OP(prepare_stages,        "Build nearby stages while waiting for a key",
+GAMEPLAY, FALSE)
+OP(quick_rest,            "Pass quiet turns quickly while resting",
+GAMEPLAY, FALSE)
 OP(use_old_target,        "Use old target by default",
 GAMEPLAY, FALSE)
 OP(pickup_always,         "Pick things up by default",
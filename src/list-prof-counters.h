@@ -0,0 +1,17 @@
+/* list-prof-counters.h - hot-path profiling counters
+ *
+ * Each entry gets a PROF_ symbol for use with PROF_BEGIN() and PROF_END().
+ * Adding or removing entries changes nothing outside the profiling code.
+ */
+
+/*   symbol              name */
+PROF(PROCESS_MONSTERS,   "process_monsters")
+PROF(PROCESS_PLAYER,     "process_player")
+PROF(PROCESS_WORLD,      "process_world")
+PROF(UPDATE_VIEW,        "update_view")
+PROF(UPDATE_NOISE,       "update_noise")
+PROF(UPDATE_SMELL,       "update_smell")
+PROF(PROJECT,            "project")
+PROF(GENERATE_CAVE,      "generate_cave")
+PROF(REDRAW_STUFF,       "redraw_stuff")
+PROF(TERM_FRESH,         "Term_fresh")
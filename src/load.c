@@ -198,9 +198,9 @@ static int rd_item(object_type * o_ptr)
 
 
 /**
- * Read a monster
+ * Read a monster, and its speed and energy
  */
-static int rd_monster(monster_type * m_ptr)
+static int rd_monster(monster_type * m_ptr, byte *speed, byte *energy)
 {
 	byte tmp8u;
 	s16b tmp16u;
@@ -215,8 +215,8 @@ static int rd_monster(monster_type * m_ptr)
 	rd_s16b(&m_ptr->hp);
 	rd_s16b(&m_ptr->maxhp);
 	rd_s16b(&m_ptr->csleep);
-	rd_byte(&m_ptr->mspeed);
-	rd_byte(&m_ptr->energy);
+	rd_byte(speed);
+	rd_byte(energy);
 	rd_byte(&m_ptr->stunned);
 	rd_byte(&m_ptr->confused);
 	rd_byte(&m_ptr->monfear);
@@ -1841,9 +1841,9 @@ int rd_stores(void)
 			}
 		}
 
-		/* Expansion */
+		/* Turnovers owed; older savefiles have none */
 		rd_u32b(&tmp32u);
-
+		st_ptr->maint_due = MIN(tmp32u, STORE_MAINT_MAX);
 	}
 
 	/* Success */
@@ -2054,11 +2054,15 @@ int rd_objects(void)
 	rd_u16b(&limit);
 
 	/* Verify maximum */
-	if (limit >= z_info->o_max) {
+	if (limit >= MAX_O_IDX) {
 		note(format("Too many (%d) object entries!", limit));
 		return (-1);
 	}
 
+	/* Make room */
+	while (limit >= o_size)
+		grow_o_list();
+
 	/* Read the dungeon items */
 	for (i = 1; i < limit; i++) {
 		object_type *i_ptr;
@@ -2106,6 +2110,11 @@ int rd_objects(void)
 
 			/* Link the floor to the object */
 			cave_o_idx[y][x] = o_idx;
+			region_add(&obj_regions, o_idx, y, x);
+
+			/* Remember seen objects */
+			if (o_ptr->marked)
+				obj_seen_add(o_idx);
 		}
 	}
 
@@ -2128,16 +2137,21 @@ int rd_monsters(void)
 	rd_u16b(&limit);
 
 	/* Hack -- verify */
-	if (limit >= z_info->m_max) {
+	if (limit >= MAX_M_IDX) {
 		note(format("Too many (%d) monster entries!", limit));
 		return (161);
 	}
 
+	/* Make room */
+	while (limit >= m_size)
+		grow_m_list();
+
 	/* Read the monsters */
 	for (i = 1; i < limit; i++) {
 		monster_type *n_ptr;
 		monster_type monster_type_body;
 		monster_race *r_ptr;
+		byte speed, energy;
 
 		int r_idx;
 
@@ -2148,7 +2162,7 @@ int rd_monsters(void)
 		(void) WIPE(n_ptr, monster_type);
 
 		/* Read the monster */
-		rd_monster(n_ptr);
+		rd_monster(n_ptr, &speed, &energy);
 
 		/* Hack -- ignore "broken" monsters */
 		if (n_ptr->r_idx <= 0)
@@ -2166,11 +2180,11 @@ int rd_monsters(void)
 
 		/* If a player ghost, some special features need to be added. */
 		if (rf_has(r_ptr->flags, RF_PLAYER_GHOST)) {
-			prepare_ghost(n_ptr->r_idx, n_ptr, TRUE);
+			prepare_ghost(n_ptr->r_idx, &speed, TRUE);
 		}
 
 		/* Place monster in dungeon */
-		if (!monster_place(n_ptr->fy, n_ptr->fx, n_ptr)) {
+		if (!monster_place(n_ptr->fy, n_ptr->fx, n_ptr, speed, energy)) {
 			note(format("Cannot place monster %d", i));
 			return (-1);
 		}
@@ -2192,7 +2206,7 @@ int rd_monsters(void)
 			continue;
 
 		/* Verify monster index */
-		if (o_ptr->held_m_idx > z_info->m_max) {
+		if (o_ptr->held_m_idx >= m_size) {
 			note("Invalid monster index");
 			return (-1);
 		}
@@ -106,6 +106,7 @@ static bool loaded_terminfo;
 typedef struct term_data {
 	term t;                 /* All term info */
 	WINDOW *win;            /* Pointer to the curses window */
+	int attr;               /* Last attribute set on the window */
 } term_data;
 
 /* Max number of windows on screen */
@@ -125,6 +126,10 @@ static term_data data[MAX_TERM_DATA];
 /* Number of initialized "term" structures */
 static int active = 0;
 
+/* The last window queued for output, and whether anything is queued */
+static term_data *fresh_last = NULL;
+static bool fresh_pending = FALSE;
+
 #ifdef A_COLOR
 
 /*
@@ -235,6 +240,24 @@ static void keymap_game_prepare(void) {
 }
 
 
+/*
+ * Send everything queued by TERM_XTRA_FRESH to the terminal in one update.
+ *
+ * Each window only marks its changes with wnoutrefresh(), so a frame that
+ * touches several subwindows costs one doupdate() and one write instead of
+ * one per window.  The last window refreshed is queued again so that the
+ * hardware cursor ends up where a plain wrefresh() would have left it.
+ */
+static void gcu_flush(void) {
+	if (!fresh_pending) return;
+
+	wnoutrefresh(fresh_last->win);
+	doupdate();
+
+	fresh_pending = FALSE;
+}
+
+
 /*
  * Suspend/Resume
  */
@@ -255,6 +278,7 @@ static errr Term_xtra_gcu_alive(int v) {
 		Term_xtra(TERM_XTRA_SHAPE, 1);
 
 		/* Flush the curses buffer */
+		gcu_flush();
 		refresh();
 
 		/* Get current cursor position */
@@ -334,6 +358,10 @@ static void Term_nuke_gcu(term *t) {
 	int x, y;
 	term_data *td = (term_data *)(t->data);
 
+	/* Send any pending output */
+	gcu_flush();
+	if (fresh_last == td) fresh_last = NULL;
+
 	/* Delete this window */
 	delwin(td->win);
 
@@ -503,6 +531,9 @@ static void do_gcu_resize(void) {
 static errr Term_xtra_gcu_event(int v) {
 	int i, j, k, mods=0;
 
+	/* Show the current frame before looking for input */
+	gcu_flush();
+
 	if (v) {
 		/* Wait for a keypress; use halfdelay(1) so if the user takes more */
 		/* than 0.2 seconds we get a chance to do updates. */
@@ -734,7 +765,11 @@ static errr Term_xtra_gcu(int n, int v) {
 		case TERM_XTRA_NOISE: write(1, "\007", 1); return 0;
 
 		/* Flush the Curses buffer */
-		case TERM_XTRA_FRESH: wrefresh(td->win); return 0;
+		case TERM_XTRA_FRESH:
+			wnoutrefresh(td->win);
+			fresh_last = td;
+			fresh_pending = TRUE;
+			return 0;
 
 #ifdef USE_CURS_SET
 		/* Change the cursor visibility */
@@ -751,7 +786,10 @@ static errr Term_xtra_gcu(int n, int v) {
 		case TERM_XTRA_FLUSH: while (!Term_xtra_gcu_event(FALSE)); return 0;
 
 		/* Delay */
-		case TERM_XTRA_DELAY: if (v > 0) usleep(1000 * v); return 0;
+		case TERM_XTRA_DELAY:
+			gcu_flush();
+			if (v > 0) usleep(1000 * v);
+			return 0;
 
 		/* React to events */
 		case TERM_XTRA_REACT: Term_xtra_gcu_react(); return 0;
@@ -806,9 +844,13 @@ static errr Term_text_gcu(int x, int y, int n, int a, const wchar_t *s) {
 		/* the high bit of the attribute indicates a reversed fg/bg */
 		int flip = a > 127 ? A_REVERSE : A_NORMAL;
 
-		wattrset(td->win, colortable[attr] | flip);
+		/* Runs in the same colour keep the window attribute as it is */
+		if (td->attr != (colortable[attr] | flip)) {
+			td->attr = colortable[attr] | flip;
+			wattrset(td->win, td->attr);
+		}
+
 		mvwaddnwstr(td->win, y, x, s, n);
-		wattrset(td->win, A_NORMAL);
 		return 0;
 	}
 #endif
@@ -833,6 +875,9 @@ static errr term_data_init_gcu(term_data *td, int rows, int cols, int y, int x)
 	if (!td->win)
 		quit("Failed to setup curses window.");
 
+	/* New windows start out with no attribute */
+	td->attr = A_NORMAL;
+
 	/* Initialize the term */
 	term_init(t, cols, rows, 256);
 
@@ -0,0 +1,411 @@
+/*
+ * File: main-null.c
+ * Purpose: Headless frontend that renders into memory, for measuring UI cost
+ *
+ * Copyright (c) 2026 FAangband contributors
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "angband.h"
+
+#ifdef USE_TEST
+
+/*
+ * Every term draws into its own framebuffer, and the frontend keeps track of
+ * what an ANSI terminal would have been sent to show the same thing: cursor
+ * moves, colour changes and UTF-8 text.  Keys are read raw from stdin, one
+ * byte per keypress, and only when the game waits for one; at the end of
+ * input the figures are printed as "null-*" lines of key=value pairs.
+ *
+ * Usage:
+ *
+ * angband -mnull -- [-nN] [-d] < keys
+ *
+ *   -nN     Use N terms of 80x24 (up to 8); subwindows get the usual flags
+ *   -d      Dump the main framebuffer when finished
+ */
+
+#define NULL_TERM_MAX 8
+
+typedef struct term_data term_data;
+struct term_data {
+	term t;
+
+	/* Framebuffer */
+	int *attrs;
+	wchar_t *chars;
+
+	/* What the emulated terminal is showing */
+	int cx, cy;
+	int attr;
+
+	/* Hook calls and what they cost */
+	unsigned long text_calls;
+	unsigned long wipe_calls;
+	unsigned long curs_calls;
+	unsigned long cells;
+	unsigned long bytes;
+
+	/* Flushes, timed from the first hook of each to TERM_XTRA_FRESH */
+	unsigned long frames;
+	bool in_frame;
+	double frame_start;
+	double frame_total;
+	double frame_max;
+};
+
+static term_data data[NULL_TERM_MAX];
+static int term_count = 1;
+static bool dump_screen = FALSE;
+
+static unsigned long keys_read = 0;
+static double run_start;
+
+static double null_now(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double) ts.tv_sec * 1000000.0 + (double) ts.tv_nsec / 1000.0;
+}
+
+/*
+ * Note the start of a flush the first time a hook is called for it.
+ */
+static void null_frame(term_data *td) {
+	if (td->in_frame) return;
+
+	td->in_frame = TRUE;
+	td->frame_start = null_now();
+}
+
+/*
+ * Count the escape sequence that moves the cursor, if it has to move.
+ */
+static void null_goto(term_data *td, int x, int y) {
+	char buf[32];
+
+	if (td->cx == x && td->cy == y) return;
+
+	td->bytes += strnfmt(buf, sizeof(buf), "\033[%d;%dH", y + 1, x + 1);
+	td->cx = x;
+	td->cy = y;
+}
+
+/*
+ * Count the escape sequence that changes colour, if it has to change.
+ * Colours are sent as 256-colour indices, with bit 7 meaning reverse video.
+ */
+static void null_color(term_data *td, int a) {
+	char buf[32];
+
+	if (td->attr == a) return;
+
+	td->bytes += strnfmt(buf, sizeof(buf), "\033[0;38;5;%d%sm", a & 0x7F,
+			(a & 0x80) ? ";7" : "");
+	td->attr = a;
+}
+
+static void null_print_term(int i) {
+	term_data *td = &data[i];
+
+	printf("null-term id=%d wid=%d hgt=%d frames=%lu text_calls=%lu "
+	       "wipe_calls=%lu curs_calls=%lu cells=%lu bytes=%lu "
+	       "flush_us=%.1f flush_us_avg=%.2f flush_us_max=%.1f\n",
+	       i, td->t.wid, td->t.hgt, td->frames, td->text_calls,
+	       td->wipe_calls, td->curs_calls, td->cells, td->bytes,
+	       td->frame_total, td->frames ? td->frame_total / td->frames : 0.0,
+	       td->frame_max);
+}
+
+static void null_dump(void) {
+	term_data *td = &data[0];
+	int x, y;
+
+	for (y = 0; y < td->t.hgt; y++) {
+		char buf[1024];
+		wchar_t line[256];
+		size_t len;
+		int w = MIN(td->t.wid, 255);
+
+		for (x = 0; x < w; x++)
+			line[x] = td->chars[y * td->t.wid + x];
+		line[w] = 0;
+
+		len = wcstombs(buf, line, sizeof(buf) - 1);
+		buf[len == (size_t)-1 ? 0 : len] = '\0';
+		printf("null-dump %s\n", buf);
+	}
+}
+
+/*
+ * Print the figures for the whole run.
+ */
+static void null_report(void) {
+	unsigned long frames = 0, calls = 0, cells = 0, bytes = 0;
+	double flush = 0.0;
+	int i;
+
+	for (i = 0; i < term_count; i++) {
+		term_data *td = &data[i];
+
+		null_print_term(i);
+
+		frames += td->frames;
+		calls += td->text_calls + td->wipe_calls + td->curs_calls;
+		cells += td->cells;
+		bytes += td->bytes;
+		flush += td->frame_total;
+	}
+
+#ifdef ALLOW_PROFILING
+	for (i = 0; i < PROF_MAX; i++) {
+		const prof_counter *c = prof_get(i);
+
+		printf("null-counter name=%s calls=%lu total_us=%.1f max_us=%.1f\n",
+		       c->name, (unsigned long)c->calls, c->total, c->max);
+	}
+#endif /* ALLOW_PROFILING */
+
+	printf("null-result terms=%d keys=%lu seconds=%.6f frames=%lu "
+	       "hook_calls=%lu cells=%lu bytes=%lu bytes_per_frame=%.1f "
+	       "flush_us=%.1f\n",
+	       term_count, keys_read, (null_now() - run_start) / 1000000.0,
+	       frames, calls, cells, bytes, frames ? (double)bytes / frames : 0.0,
+	       flush);
+
+	if (dump_screen) null_dump();
+
+	fflush(stdout);
+}
+
+
+static void Term_init_null(term *t) {
+	term_data *td = (term_data *)(t->data);
+	int size = t->wid * t->hgt;
+	int i;
+
+	td->attrs = mem_zalloc(size * sizeof(int));
+	td->chars = mem_zalloc(size * sizeof(wchar_t));
+
+	for (i = 0; i < size; i++)
+		td->chars[i] = ' ';
+
+	/* The terminal state is unknown until something is sent */
+	td->cx = td->cy = -1;
+	td->attr = -1;
+}
+
+static void Term_nuke_null(term *t) {
+	term_data *td = (term_data *)(t->data);
+
+	mem_free(td->attrs);
+	mem_free(td->chars);
+	td->attrs = NULL;
+	td->chars = NULL;
+}
+
+/*
+ * Hand the game one key from stdin.  Polls that don't wait never read, so
+ * a replay doesn't depend on how often the game checks for disturbances.
+ */
+static errr Term_xtra_null_event(int v) {
+	int ch;
+
+	if (!v) return 1;
+
+	ch = getchar();
+	if (ch == EOF) {
+		null_report();
+		quit(NULL);
+	}
+
+	keys_read++;
+
+	switch (ch) {
+		case 9: ch = KC_TAB; break;
+		case 10:
+		case 13: ch = KC_ENTER; break;
+		case 27: ch = ESCAPE; break;
+		case 127: ch = KC_BACKSPACE; break;
+	}
+
+	Term_keypress(ch, 0);
+
+	return 0;
+}
+
+static errr Term_xtra_null(int n, int v) {
+	term_data *td = (term_data *)(Term->data);
+
+	switch (n) {
+		case TERM_XTRA_CLEAR: {
+			int i;
+
+			null_frame(td);
+			for (i = 0; i < td->t.wid * td->t.hgt; i++) {
+				td->attrs[i] = td->t.attr_blank;
+				td->chars[i] = ' ';
+			}
+
+			/* Home the cursor and clear the screen */
+			td->bytes += 7;
+			td->cx = td->cy = 0;
+			return 0;
+		}
+
+		case TERM_XTRA_FRESH: {
+			double elapsed;
+
+			null_frame(td);
+			elapsed = null_now() - td->frame_start;
+			td->in_frame = FALSE;
+
+			td->frames++;
+			td->frame_total += elapsed;
+			if (elapsed > td->frame_max) td->frame_max = elapsed;
+			return 0;
+		}
+
+		case TERM_XTRA_EVENT: return Term_xtra_null_event(v);
+
+		case TERM_XTRA_NOISE:
+		case TERM_XTRA_SHAPE:
+		case TERM_XTRA_ALIVE:
+		case TERM_XTRA_FLUSH:
+		case TERM_XTRA_DELAY:
+		case TERM_XTRA_REACT:
+			return 0;
+	}
+
+	/* Unknown event */
+	return 1;
+}
+
+static errr Term_curs_null(int x, int y) {
+	term_data *td = (term_data *)(Term->data);
+
+	null_frame(td);
+	td->curs_calls++;
+	null_goto(td, x, y);
+
+	return 0;
+}
+
+static errr Term_wipe_null(int x, int y, int n) {
+	term_data *td = (term_data *)(Term->data);
+	int i;
+
+	null_frame(td);
+	td->wipe_calls++;
+	td->cells += n;
+
+	for (i = 0; i < n; i++) {
+		td->attrs[y * td->t.wid + x + i] = td->t.attr_blank;
+		td->chars[y * td->t.wid + x + i] = ' ';
+	}
+
+	null_goto(td, x, y);
+	null_color(td, td->t.attr_blank);
+
+	/* Clear to end of line, or write spaces */
+	if (x + n >= td->t.wid) {
+		td->bytes += 3;
+	} else {
+		td->bytes += n;
+		td->cx += n;
+	}
+
+	return 0;
+}
+
+static errr Term_text_null(int x, int y, int n, int a, const wchar_t *s) {
+	term_data *td = (term_data *)(Term->data);
+	char buf[16];
+	int i;
+
+	null_frame(td);
+	td->text_calls++;
+	td->cells += n;
+
+	null_goto(td, x, y);
+	null_color(td, a);
+
+	for (i = 0; i < n; i++) {
+		int len = wctomb(buf, s[i]);
+
+		td->attrs[y * td->t.wid + x + i] = a;
+		td->chars[y * td->t.wid + x + i] = s[i];
+		td->bytes += (len > 0) ? len : 1;
+	}
+
+	td->cx += n;
+
+	return 0;
+}
+
+
+static void term_data_link(int i) {
+	term_data *td = &data[i];
+	term *t = &td->t;
+
+	term_init(t, 80, 24, 256);
+
+	/* Erase with "white space" */
+	t->attr_blank = TERM_WHITE;
+	t->char_blank = ' ';
+
+	t->init_hook = Term_init_null;
+	t->nuke_hook = Term_nuke_null;
+
+	t->xtra_hook = Term_xtra_null;
+	t->curs_hook = Term_curs_null;
+	t->wipe_hook = Term_wipe_null;
+	t->text_hook = Term_text_null;
+
+	t->data = td;
+
+	Term_activate(t);
+
+	angband_term[i] = t;
+}
+
+const char help_null[] = "Headless, subopts -nN (terms) -d(ump screen)";
+
+errr init_null(int argc, char *argv[]) {
+	int i;
+
+	/* Skip over argv[0] */
+	for (i = 1; i < argc; i++) {
+		if (prefix(argv[i], "-n")) {
+			term_count = atoi(&argv[i][2]);
+			if (term_count > NULL_TERM_MAX) term_count = NULL_TERM_MAX;
+			else if (term_count < 1) term_count = 1;
+			continue;
+		}
+		if (!strcmp(argv[i], "-d")) {
+			dump_screen = TRUE;
+			continue;
+		}
+		printf("init-null: bad argument '%s'\n", argv[i]);
+	}
+
+	/* Link the main term last so that it ends up active */
+	for (i = term_count - 1; i >= 0; i--)
+		term_data_link(i);
+
+	run_start = null_now();
+
+	return 0;
+}
+#endif /* USE_TEST */
@@ -19,30 +19,209 @@
 #include "angband.h"
 #include "birth.h"
 #include "buildid.h"
+#include "cave.h"
+#include "cmds.h"
+#include "game-cmd.h"
+#include "generate.h"
+#include "monster.h"
+#include "option.h"
 
 #ifdef USE_TEST
 
+#include <sys/resource.h>
+
 static int prompt = 0;
 static int verbose = 0;
-static int nextkey = 0;
 
-static void c_key(char *rest) {
+/* Text and wipe hook calls, and the cells they covered */
+static unsigned long term_calls = 0;
+static unsigned long term_cells = 0;
+
+/*
+ * Keys from the script waiting to be handed to the game.
+ */
+#define KEYQ_SIZE 1024
+
+static keycode_t keyq[KEYQ_SIZE];
+static int keyq_head = 0;
+static int keyq_tail = 0;
+
+static void keyq_push(keycode_t k) {
+	int next = (keyq_head + 1) % KEYQ_SIZE;
+
+	/* Drop keys rather than overwrite ones not yet delivered */
+	if (!k || next == keyq_tail) return;
+
+	keyq[keyq_head] = k;
+	keyq_head = next;
+}
+
+/*
+ * Benchmark state.  A run is split into named phases by "bench-phase";
+ * each phase records wall time, game turns, levels arrived on and cells
+ * drawn, and the run is reported as "bench-*" lines of key=value pairs.
+ * Phases that spend no game turns, such as taking stairs, are reported by
+ * levels per second alone.
+ */
+#define BENCH_MAX_PHASES 32
+
+struct bench_phase {
+	char name[32];
+	double seconds;
+	s32b turns;
+	u32b levels;
+	unsigned long cells;
+};
+
+static struct bench_phase phases[BENCH_MAX_PHASES];
+static int num_phases = 0;
+static bool bench_running = FALSE;
+static double bench_phase_start;
+static s32b bench_phase_turn;
+static u32b bench_phase_levels;
+static unsigned long bench_phase_cells;
+static u32b bench_seed = 0;
+
+static double bench_now(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double) ts.tv_sec + (double) ts.tv_nsec / 1000000000.0;
+}
+
+/*
+ * Levels arrived on so far, whether built then or in advance
+ */
+static u32b bench_levels(void) {
+	return gen_stat.levels + gen_stat.prepared_used;
+}
+
+/*
+ * Print the rates of game turns and of levels arrived on, leaving out
+ * whichever did not happen
+ */
+static void bench_print_rates(double seconds, s32b turns, u32b levels) {
+	if (turns)
+		printf(" turns=%ld turns_per_sec=%.1f", (long)turns,
+		       seconds > 0 ? turns / seconds : 0.0);
+	if (levels || !turns)
+		printf(" levels=%lu levels_per_sec=%.1f", (unsigned long)levels,
+		       seconds > 0 ? levels / seconds : 0.0);
+}
+
+static long bench_peak_rss(void) {
+	struct rusage ru;
+
+	if (getrusage(RUSAGE_SELF, &ru)) return -1;
+
+	/* Kilobytes on Linux, bytes on OS X */
+#ifdef __APPLE__
+	return ru.ru_maxrss / 1024;
+#else
+	return ru.ru_maxrss;
+#endif
+}
+
+static void bench_phase_end(void) {
+	struct bench_phase *ph;
+
+	if (!bench_running) return;
+
+	ph = &phases[num_phases - 1];
+	ph->seconds = bench_now() - bench_phase_start;
+	ph->turns = turn - bench_phase_turn;
+	ph->levels = bench_levels() - bench_phase_levels;
+	ph->cells = term_cells - bench_phase_cells;
+	bench_running = FALSE;
+}
+
+static void bench_report(void) {
+	double seconds = 0.0;
+	s32b turns = 0;
+	u32b levels = 0;
+	int i;
+
+	bench_phase_end();
+
+	if (!num_phases) return;
+
+	for (i = 0; i < num_phases; i++) {
+		struct bench_phase *ph = &phases[i];
+
+		printf("bench-phase name=%s seconds=%.6f", ph->name, ph->seconds);
+		bench_print_rates(ph->seconds, ph->turns, ph->levels);
+		printf(" term_cells=%lu\n", ph->cells);
+
+		seconds += ph->seconds;
+		turns += ph->turns;
+		levels += ph->levels;
+	}
+
+#ifdef ALLOW_PROFILING
+	for (i = 0; i < PROF_MAX; i++) {
+		const prof_counter *c = prof_get(i);
+
+		printf("bench-counter name=%s calls=%lu total_us=%.1f max_us=%.1f\n",
+		       c->name, (unsigned long)c->calls, c->total, c->max);
+	}
+#endif /* ALLOW_PROFILING */
+
+	printf("bench-result seed=%lu phases=%d seconds=%.6f",
+	       (unsigned long)bench_seed, num_phases, seconds);
+	bench_print_rates(seconds, turns, levels);
+	printf(" peak_rss_kb=%ld depth=%d clev=%d dead=%d\n", bench_peak_rss(),
+	       p_ptr->depth, p_ptr->lev, p_ptr->is_dead ? 1 : 0);
+	fflush(stdout);
+
+	num_phases = 0;
+}
+
+static keycode_t parse_key(const char *rest) {
 	if (!strcmp(rest, "left")) {
-		nextkey = ARROW_LEFT;
+		return ARROW_LEFT;
 	} else if (!strcmp(rest, "right")) {
-		nextkey = ARROW_RIGHT;
+		return ARROW_RIGHT;
 	} else if (!strcmp(rest, "up")) {
-		nextkey = ARROW_UP;
+		return ARROW_UP;
 	} else if (!strcmp(rest, "down")) {
-		nextkey = ARROW_DOWN;
+		return ARROW_DOWN;
 	} else if (!strcmp(rest, "space")) {
-		nextkey = ' ';
+		return ' ';
 	} else if (!strcmp(rest, "enter")) {
-		nextkey = '\n';
+		return '\n';
+	} else if (!strcmp(rest, "escape")) {
+		return ESCAPE;
 	} else if (rest[0] == 'C' && rest[1] == '-') {
-		nextkey = KTRL(rest[2]);
+		return KTRL(rest[2]);
 	} else {
-		nextkey = rest[0];
+		return rest[0];
+	}
+}
+
+static void c_key(char *rest) {
+	if (rest) keyq_push(parse_key(rest));
+}
+
+/*
+ * Queue a string of keys.  "\e" is escape, "\n" is enter, "\\" is a
+ * backslash and "^X" is control-X.
+ */
+static void c_keys(char *rest) {
+	char *s;
+
+	for (s = rest; s && *s; s++) {
+		if (s[0] == '\\' && s[1]) {
+			s++;
+			if (*s == 'e') keyq_push(ESCAPE);
+			else if (*s == 'n') keyq_push('\n');
+			else keyq_push(*s);
+		} else if (s[0] == '^' && s[1]) {
+			s++;
+			keyq_push(KTRL(*s));
+		} else {
+			keyq_push(*s);
+		}
 	}
 }
 
@@ -51,9 +230,18 @@ static void c_noop(char *rest) {
 }
 
 static void c_quit(char *rest) {
+	bench_report();
 	quit(NULL);
 }
 
+static void c_option(char *rest) {
+	char *name = strtok(rest ? rest : "", " ");
+	char *value = strtok(NULL, " ");
+
+	if (!name || !option_set(name, !value || !strcmp(value, "yes")))
+		printf("option: bad option '%s'\n", name ? name : "");
+}
+
 static void c_verbose(char *rest) {
 	if (rest && !strcmp(rest, "0")) {
 		printf("cmd-verbose: off\n");
@@ -69,60 +257,1041 @@ static void c_version(char *rest) {
 }
 
 /* Player commands */
+static const char *map_names[MAP_MAX] = {
+	"compressed", "extended", "dungeon", "fanilla"
+};
+
+/*
+ * Roll up a character from a template "sex race class [map]", by feeding
+ * the birth commands straight to the game rather than driving the menus.
+ */
 static void c_player_birth(char *rest) {
-	char *sex = strtok(rest, " ");
+	char *sex = strtok(rest ? rest : "", " ");
 	char *race = strtok(NULL, " ");
 	char *class = strtok(NULL, " ");
-	int i;
-	struct player_class *c;
-	struct player_race *r;
+	char *map = strtok(NULL, " ");
+	char modes[GAME_MODE_MAX + 1];
+	int s, r, c, m;
 
 	if (!sex) sex = "Female";
-	if (!race) race = "Human";
+	if (!race) race = "Adan";
 	if (!class) class = "Warrior";
+	if (!map) map = "extended";
 
-	for (i = 0; i < MAX_SEXES; i++) {
-		if (!strcmp(sex, sex_info[i].title)) {
-			p_ptr->psex = i;
+	for (s = 0; s < MAX_SEXES; s++)
+		if (!my_stricmp(sex, sex_info[s].title))
 			break;
-		}
-	}
-
-	if (i == MAX_SEXES) {
+	if (s == MAX_SEXES) {
 		printf("player-birth: bad sex '%s'\n", sex);
 		return;
 	}
 
-	for (r = races; r; r = r->next)
-		if (!strcmp(race, r->name))
+	for (r = 0; r < z_info->p_max; r++)
+		if (p_info[r].name && !my_stricmp(race, p_info[r].name))
 			break;
-	if (!r) {
+	if (r == z_info->p_max) {
 		printf("player-birth: bad race '%s'\n", race);
 		return;
 	}
 
-	for (c = classes; c; c = c->next)
-		if (!strcmp(class, c->name))
+	for (c = 0; c < z_info->c_max; c++)
+		if (c_info[c].name && !my_stricmp(class, c_info[c].name))
 			break;
-
-	if (!c) {
+	if (c == z_info->c_max) {
 		printf("player-birth: bad class '%s'\n", class);
 		return;
 	}
 
-	player_generate(p_ptr, NULL, r, c);
+	for (m = 0; m < MAP_MAX; m++)
+		if (!my_stricmp(map, map_names[m]))
+			break;
+	if (m == MAP_MAX) {
+		printf("player-birth: bad map '%s'\n", map);
+		return;
+	}
+
+	/* No game modes */
+	memset(modes, 'N', GAME_MODE_MAX);
+	modes[GAME_MODE_MAX] = '\0';
+
+	cmd_insert(CMD_BIRTH_RESET);
+	cmd_insert(CMD_SET_MAP);
+	cmd_set_arg_choice(cmd_get_top(), 0, m);
+	cmd_insert(CMD_SET_MODES);
+	cmd_set_arg_string(cmd_get_top(), 0, modes);
+	cmd_insert(CMD_CHOOSE_SEX);
+	cmd_set_arg_choice(cmd_get_top(), 0, s);
+	cmd_insert(CMD_CHOOSE_RACE);
+	cmd_set_arg_choice(cmd_get_top(), 0, r);
+	cmd_insert(CMD_CHOOSE_CLASS);
+	cmd_set_arg_choice(cmd_get_top(), 0, c);
+	cmd_insert(CMD_FINALIZE_OPTIONS);
+	cmd_insert(CMD_RESET_STATS);
+	cmd_set_arg_choice(cmd_get_top(), 0, TRUE);
+	cmd_insert(CMD_NAME_CHOICE);
+	cmd_set_arg_string(cmd_get_top(), 0, "Bench");
+	cmd_insert(CMD_ACCEPT_CHARACTER);
+
+	/* Back out of whichever birth menu is waiting for a key */
+	keyq_push(ESCAPE);
 }
 
 static void c_player_class(char *rest) {
-	printf("player-class: %s\n", p_ptr->class->name);
+	printf("player-class: %s\n", cp_ptr->name);
 }
 
 static void c_player_race(char *rest) {
-	printf("player-race: %s\n", p_ptr->race->name);
+	printf("player-race: %s\n", rp_ptr->name);
 }
 
 static void c_player_sex(char *rest) {
-	printf("player-sex: %s\n", p_ptr->sex->title);
+	printf("player-sex: %s\n", sp_ptr->title);
+}
+
+static void c_player_heal(char *rest) {
+	/* Pick up any change to maximum hitpoints or mana first */
+	if (p_ptr->update) update_stuff(p_ptr);
+
+	p_ptr->chp = p_ptr->mhp;
+	p_ptr->chp_frac = 0;
+	p_ptr->csp = p_ptr->msp;
+	p_ptr->csp_frac = 0;
+	p_ptr->food = PY_FOOD_FULL - 1;
+	p_ptr->redraw |= (PR_HP | PR_MANA);
+}
+
+static void c_player_wound(char *rest) {
+	/* Leave the player with the given hitpoints and no mana */
+	p_ptr->chp = rest ? atoi(rest) : 1;
+	if (p_ptr->chp < 1) p_ptr->chp = 1;
+	if (p_ptr->chp > p_ptr->mhp) p_ptr->chp = p_ptr->mhp;
+	p_ptr->chp_frac = 0;
+	p_ptr->csp = 0;
+	p_ptr->csp_frac = 0;
+	p_ptr->redraw |= (PR_HP | PR_MANA);
+}
+
+static void c_player_exp(char *rest) {
+	if (rest) gain_exp(atoi(rest));
+}
+
+/* World commands */
+
+/*
+ * Fix the RNG, and redo everything play_game() has already drawn from it,
+ * so a run is reproducible.  Must come before player-birth.
+ */
+static void c_seed(char *rest) {
+	int i;
+
+	bench_seed = rest ? strtoul(rest, NULL, 0) : 0;
+
+	Rand_quick = FALSE;
+	Rand_state_init(bench_seed);
+
+	seed_flavor = randint0(0x10000000);
+	for (i = 0; i < 10; i++)
+		seed_town[i] = randint0(0x10000000);
+}
+
+/*
+ * Leave for another stage, given as a stage index or as "down".
+ */
+static void c_stage(char *rest) {
+	int stage;
+
+	if (!character_dungeon) return;
+
+	if (rest && !strcmp(rest, "down"))
+		stage = stage_map[p_ptr->stage][DOWN];
+	else
+		stage = rest ? atoi(rest) : 0;
+
+	if (stage <= 0 || stage >= NUM_STAGES) {
+		printf("stage: bad stage '%s'\n", rest ? rest : "");
+		return;
+	}
+
+	p_ptr->stage = stage;
+	p_ptr->depth = stage_map[stage][DEPTH];
+	p_ptr->last_stage = NOWHERE;
+	p_ptr->leaving = TRUE;
+
+	/* Finish the command prompt that is waiting */
+	keyq_push(ESCAPE);
+}
+
+static void c_summon(char *rest) {
+	int i, num = rest ? atoi(rest) : 1;
+
+	if (!character_dungeon) return;
+
+	for (i = 0; i < num; i++)
+		summon_specific(p_ptr->py, p_ptr->px, TRUE, p_ptr->depth, 0);
+
+	p_ptr->update |= (PU_MONSTERS);
+}
+
+/*
+ * Check projectable_player() against projectable() for every grid in range,
+ * with the player moved to <n> random empty grids of the current level.
+ */
+static void c_check_project(char *rest) {
+	int i, y, x, n = rest ? atoi(rest) : 1;
+	int oy = p_ptr->py, ox = p_ptr->px;
+	int grids = 0, bad = 0;
+
+	if (!character_dungeon) return;
+
+	for (i = 0; i < n; i++) {
+		int py, px, pass;
+
+		/* Move the player, and let update_view() reset the field */
+		do {
+			py = randint0(DUNGEON_HGT);
+			px = randint0(DUNGEON_WID);
+		} while (!in_bounds_fully(py, px) || !cave_empty_bold(py, px));
+		monster_swap(p_ptr->py, p_ptr->px, py, px);
+		update_stuff(p_ptr);
+
+		/* The second pass is answered from the field */
+		for (pass = 0; pass < 2; pass++) {
+			for (y = py - MAX_RANGE; y <= py + MAX_RANGE; y++) {
+				for (x = px - MAX_RANGE; x <= px + MAX_RANGE; x++) {
+					if (!in_bounds(y, x)) continue;
+
+					grids++;
+					if (projectable_player(y, x, PROJECT_NONE) !=
+						projectable(y, x, py, px, PROJECT_NONE))
+						bad++;
+					if (projectable_player(y, x, PROJECT_CHCK) !=
+						projectable(y, x, py, px, PROJECT_CHCK))
+						bad++;
+				}
+			}
+		}
+	}
+
+	/* Put the player back */
+	if (cave_empty_bold(oy, ox))
+		monster_swap(p_ptr->py, p_ptr->px, oy, ox);
+	update_stuff(p_ptr);
+
+	printf("check-project positions=%d grids=%d mismatches=%d\n",
+		   n, grids, bad);
+}
+
+static int cmp_s16b(const void *a, const void *b) {
+	return *(const s16b *)a - *(const s16b *)b;
+}
+
+static bool region_holds(const region_index *r, int idx, int y, int x) {
+	int i;
+
+	for (i = r->head[y / REGION_GRIDS][x / REGION_GRIDS]; i; i = r->next[i])
+		if (i == idx) return TRUE;
+
+	return FALSE;
+}
+
+/*
+ * Check that every monster and floor object is in the region index under
+ * the region it is in, and that nothing else is.
+ */
+static void c_check_regions(char *rest) {
+	s16b *list = C_ZNEW(MAX(m_size, o_size), s16b);
+	int i, n, j, monsters = 0, objects = 0, bad = 0;
+
+	if (!character_dungeon) {
+		FREE(list);
+		return;
+	}
+
+	/* Monsters */
+	n = region_scan(&mon_regions, 0, 0, 255, list);
+	sort(list, n, sizeof(s16b), cmp_s16b);
+	for (i = 1, j = 0; i < m_max; i++) {
+		monster_type *m_ptr = &m_list[i];
+
+		if (!m_ptr->r_idx) continue;
+		monsters++;
+		if ((j >= n) || (list[j++] != i)) bad++;
+		if (!region_holds(&mon_regions, i, m_ptr->fy, m_ptr->fx)) bad++;
+	}
+	if (j != n) bad++;
+
+	/* Floor objects */
+	n = region_scan(&obj_regions, 0, 0, 255, list);
+	sort(list, n, sizeof(s16b), cmp_s16b);
+	for (i = 1, j = 0; i < o_max; i++) {
+		object_type *o_ptr = &o_list[i];
+
+		if (!o_ptr->k_idx || o_ptr->held_m_idx) continue;
+		objects++;
+		if ((j >= n) || (list[j++] != i)) bad++;
+		if (!region_holds(&obj_regions, i, o_ptr->iy, o_ptr->ix)) bad++;
+	}
+	if (j != n) bad++;
+
+	FREE(list);
+
+	printf("check-regions monsters=%d objects=%d mismatches=%d\n",
+		   monsters, objects, bad);
+}
+
+/* Benchmark commands */
+static void c_bench_phase(char *rest) {
+	struct bench_phase *ph;
+
+	bench_phase_end();
+
+	if (num_phases == BENCH_MAX_PHASES) {
+		printf("bench-phase: too many phases\n");
+		return;
+	}
+
+	ph = &phases[num_phases++];
+	my_strcpy(ph->name, rest ? rest : "run", sizeof(ph->name));
+
+#ifdef ALLOW_PROFILING
+	if (num_phases == 1) prof_reset();
+#endif /* ALLOW_PROFILING */
+
+	bench_running = TRUE;
+	bench_phase_turn = turn;
+	bench_phase_levels = bench_levels();
+	bench_phase_cells = term_cells;
+	bench_phase_start = bench_now();
+}
+
+static void c_bench_report(char *rest) {
+	bench_report();
+}
+
+static const char *stage_type_names[NUM_STAGE_TYPES] = {
+	"town", "plain", "forest", "mountain", "swamp",
+	"river", "desert", "cave", "valley", "mountaintop"
+};
+
+struct gen_totals {
+	u32b stages;
+	double seconds;
+	gen_stats gen;
+	unsigned long allocs;
+	unsigned long bytes;
+};
+
+static void print_gen_totals(const char *what, const struct gen_totals *t) {
+	printf("%s levels=%lu seconds=%.6f levels_per_sec=%.1f "
+	       "attempts=%lu retries=%lu themed=%lu too_many_objects=%lu "
+	       "too_many_monsters=%lu boring=%lu vaults=%lu "
+	       "discarded_objects=%lu discarded_monsters=%lu scratch_peak=%lu "
+	       "allocs=%lu alloc_bytes=%lu\n",
+	       what, (unsigned long)t->gen.levels, t->seconds,
+	       t->seconds > 0 ? t->gen.levels / t->seconds : 0.0,
+	       (unsigned long)t->gen.attempts,
+	       (unsigned long)(t->gen.attempts - t->gen.levels),
+	       (unsigned long)t->gen.themed,
+	       (unsigned long)t->gen.too_many_objects,
+	       (unsigned long)t->gen.too_many_monsters,
+	       (unsigned long)t->gen.boring, (unsigned long)t->gen.vaults,
+	       (unsigned long)t->gen.discarded_objects,
+	       (unsigned long)t->gen.discarded_monsters,
+	       (unsigned long)t->gen.scratch_peak, t->allocs, t->bytes);
+}
+
+/*
+ * Hash the terrain, monsters and objects of the current level, so that
+ * runs of the same seed can be compared between builds.
+ */
+static u32b level_checksum(void) {
+	u32b sum = 0;
+	int y, x, i;
+
+	for (y = 0; y < DUNGEON_HGT; y++)
+		for (x = 0; x < DUNGEON_WID; x++)
+			sum = sum * 31 + cave_feat[y][x];
+
+	for (i = 1; i < m_max; i++)
+		sum = sum * 31 + (m_list[i].r_idx << 16) + (m_list[i].fy << 8) +
+			m_list[i].fx;
+
+	for (i = 1; i < o_max; i++)
+		sum = sum * 31 + (o_list[i].k_idx << 16) + (o_list[i].iy << 8) +
+			o_list[i].ix;
+
+	return sum;
+}
+
+/*
+ * "bench-gen <n> [first [last]]" generates n levels for each stage in the
+ * range, reporting every stage and then the totals for each stage type.
+ * The player is then sent back to a fresh level of the stage they were on.
+ */
+static void c_bench_gen(char *rest) {
+	struct gen_totals types[NUM_STAGE_TYPES];
+	char *arg = strtok(rest ? rest : "", " ");
+	int num = arg ? atoi(arg) : 1;
+	int first, last, stage, i;
+	int old_stage = p_ptr->stage;
+
+	if (!character_dungeon) return;
+
+	/* Default to every stage, or just the first one given */
+	arg = strtok(NULL, " ");
+	first = arg ? atoi(arg) : 0;
+	last = arg ? first : NUM_STAGES - 1;
+	arg = strtok(NULL, " ");
+	if (arg) last = atoi(arg);
+
+	if (first < 0) first = 0;
+	if (last >= NUM_STAGES) last = NUM_STAGES - 1;
+
+	memset(types, 0, sizeof(types));
+
+	for (stage = first; stage <= last; stage++) {
+		int type = stage_map[stage][STAGE_TYPE];
+		struct gen_totals t, *tt = &types[type];
+		gen_stats before = gen_stat;
+		unsigned long allocs = mem_allocs;
+		unsigned long bytes = mem_alloc_bytes;
+		u32b checksum = 0;
+		double start;
+		char what[80];
+
+		/* Unused stage */
+		if (stage_map[stage][LOCALITY] == NOWHERE) continue;
+
+		p_ptr->stage = stage;
+		p_ptr->depth = stage_map[stage][DEPTH];
+		p_ptr->last_stage = NOWHERE;
+
+		start = bench_now();
+		for (i = 0; i < num; i++) {
+			generate_cave();
+			checksum = checksum * 31 + level_checksum();
+		}
+
+		t.stages = 1;
+		t.seconds = bench_now() - start;
+		t.gen.levels = gen_stat.levels - before.levels;
+		t.gen.themed = gen_stat.themed - before.themed;
+		t.gen.attempts = gen_stat.attempts - before.attempts;
+		t.gen.too_many_objects =
+			gen_stat.too_many_objects - before.too_many_objects;
+		t.gen.too_many_monsters =
+			gen_stat.too_many_monsters - before.too_many_monsters;
+		t.gen.boring = gen_stat.boring - before.boring;
+		t.gen.vaults = gen_stat.vaults - before.vaults;
+		t.gen.discarded_objects =
+			gen_stat.discarded_objects - before.discarded_objects;
+		t.gen.discarded_monsters =
+			gen_stat.discarded_monsters - before.discarded_monsters;
+		t.gen.scratch_peak = gen_stat.scratch_peak;
+		t.allocs = mem_allocs - allocs;
+		t.bytes = mem_alloc_bytes - bytes;
+
+		strnfmt(what, sizeof(what),
+		        "bench-gen stage=%d type=%s depth=%d checksum=%08lx", stage,
+		        stage_type_names[type], p_ptr->depth, (unsigned long)checksum);
+		print_gen_totals(what, &t);
+
+		tt->stages++;
+		tt->seconds += t.seconds;
+		tt->gen.levels += t.gen.levels;
+		tt->gen.themed += t.gen.themed;
+		tt->gen.attempts += t.gen.attempts;
+		tt->gen.too_many_objects += t.gen.too_many_objects;
+		tt->gen.too_many_monsters += t.gen.too_many_monsters;
+		tt->gen.boring += t.gen.boring;
+		tt->gen.vaults += t.gen.vaults;
+		tt->gen.discarded_objects += t.gen.discarded_objects;
+		tt->gen.discarded_monsters += t.gen.discarded_monsters;
+		tt->gen.scratch_peak = MAX(tt->gen.scratch_peak, t.gen.scratch_peak);
+		tt->allocs += t.allocs;
+		tt->bytes += t.bytes;
+	}
+
+	for (i = 0; i < NUM_STAGE_TYPES; i++) {
+		char what[80];
+
+		if (!types[i].stages) continue;
+
+		strnfmt(what, sizeof(what), "bench-gen-type type=%s stages=%lu",
+		        stage_type_names[i], (unsigned long)types[i].stages);
+		print_gen_totals(what, &types[i]);
+	}
+	fflush(stdout);
+
+	/* Go back to where we were */
+	p_ptr->stage = old_stage;
+	p_ptr->depth = stage_map[old_stage][DEPTH];
+	p_ptr->last_stage = NOWHERE;
+	p_ptr->leaving = TRUE;
+	keyq_push(ESCAPE);
+}
+
+/*
+ * "bench-prepare <moves>" builds the stages around the player in advance,
+ * as idle_update() would, then takes the nearest way down and reports how
+ * long the move took, whether its stage was ready, and whether the monster
+ * counts of the level arrived on agree with r_info.
+ */
+static void c_bench_prepare(char *rest) {
+	int moves = rest ? atoi(rest) : 1;
+	double prep_secs = 0.0, move_secs = 0.0;
+	unsigned long bad_counts = 0;
+	gen_stats before = gen_stat;
+	int i;
+
+	if (!character_dungeon) return;
+
+	for (i = 0; i < moves; i++) {
+		int y, x, best = -1, by = 0, bx = 0, r;
+		double start = bench_now();
+		size_t j;
+
+		while (prepare_stages());
+		prep_secs += bench_now() - start;
+
+		/* Nearest stair or path down */
+		for (y = 0; y < level_hgt; y++) {
+			for (x = 0; x < level_wid; x++) {
+				feature_type *f_ptr = &f_info[cave_feat[y][x]];
+				int d = distance(p_ptr->py, p_ptr->px, y, x);
+
+				if (!tf_has(f_ptr->flags, TF_DOWNSTAIR)) continue;
+				if (cave_feat[y][x] == FEAT_MORE_SHAFT) continue;
+				if (best >= 0 && d >= best) continue;
+				best = d;
+				by = y;
+				bx = x;
+			}
+		}
+		if (best < 0) break;
+
+		p_ptr->last_stage = p_ptr->stage;
+		p_ptr->path_coord = 0;
+		if (cave_feat[by][bx] == FEAT_MORE) {
+			p_ptr->stage = stage_map[p_ptr->stage][DOWN];
+			p_ptr->create_stair = FEAT_LESS;
+		} else {
+			for (j = 0; j < N_ELEMENTS(path_data); j++)
+				if (path_data[j].path == cave_feat[by][bx]) break;
+			if (j == N_ELEMENTS(path_data)) break;
+			p_ptr->stage = stage_map[p_ptr->stage][path_data[j].direction];
+			p_ptr->create_stair = path_data[j].return_path;
+			p_ptr->path_coord = path_data[j].eastwest ? by : bx;
+		}
+		if (!p_ptr->stage) break;
+		p_ptr->depth = stage_map[p_ptr->stage][DEPTH];
+
+		start = bench_now();
+		generate_cave();
+		move_secs += bench_now() - start;
+
+		/* Every monster counted should be on this level */
+		for (r = 1; r < z_info->r_max; r++) {
+			int n = 0, k;
+
+			for (k = 1; k < m_max; k++)
+				if (m_list[k].r_idx == r) n++;
+			if (r_info[r].cur_num != n) bad_counts++;
+		}
+	}
+
+	printf("bench-prepare moves=%d prepared=%lu used=%lu "
+	       "prepare_seconds=%.6f move_seconds=%.6f bad_counts=%lu "
+	       "stage=%d\n", i,
+	       (unsigned long)(gen_stat.prepared - before.prepared),
+	       (unsigned long)(gen_stat.prepared_used - before.prepared_used),
+	       prep_secs, move_secs, bad_counts, p_ptr->stage);
+	fflush(stdout);
+
+	p_ptr->leaving = TRUE;
+	keyq_push(ESCAPE);
+}
+
+/*
+ * "bench-spell <rounds> [monsters]" fills the level around the player with
+ * up to <monsters> spellcasters and has each of them choose a ranged attack
+ * <rounds> times.  The checksum of the choices is for comparing builds run
+ * from the same seed.
+ */
+static void c_bench_spell(char *rest) {
+	char *arg = strtok(rest ? rest : "", " ");
+	int rounds = arg ? atoi(arg) : 100;
+	int want, placed = 0, tries, round, i;
+	unsigned long calls = 0, cast = 0;
+	u32b checksum = 0;
+	double start, seconds;
+
+	if (!character_dungeon) return;
+
+	arg = strtok(NULL, " ");
+	want = arg ? atoi(arg) : 100;
+
+	/* Place casters in range of the player */
+	for (tries = 0; placed < want && tries < want * 100; tries++) {
+		int y = p_ptr->py + randint0(2 * MAX_RANGE + 1) - MAX_RANGE;
+		int x = p_ptr->px + randint0(2 * MAX_RANGE + 1) - MAX_RANGE;
+		int r_idx = randint1(z_info->r_max - 1);
+		monster_race *r_ptr = &r_info[r_idx];
+
+		if (!r_ptr->name || rsf_is_empty(r_ptr->spell_flags)) continue;
+		if (rf_has(r_ptr->flags, RF_UNIQUE)) continue;
+		if (rf_has(r_ptr->flags, RF_PLAYER_GHOST)) continue;
+		if (!in_bounds_fully(y, x) || !cave_empty_bold(y, x)) continue;
+
+		if (place_monster_aux(y, x, r_idx, FALSE, FALSE))
+			placed++;
+	}
+	update_monsters(TRUE);
+
+	start = bench_now();
+	for (round = 0; round < rounds; round++) {
+		for (i = 1; i < m_max; i++) {
+			monster_type *m_ptr = &m_list[i];
+			int spell;
+
+			if (!m_ptr->r_idx) continue;
+			if (rsf_is_empty(r_info[m_ptr->r_idx].spell_flags)) continue;
+
+			spell = choose_ranged_attack(i, FALSE, 0);
+			calls++;
+			if (spell) cast++;
+			checksum = checksum * 31 + spell;
+		}
+	}
+	seconds = bench_now() - start;
+
+	printf("bench-spell placed=%d rounds=%d calls=%lu cast=%lu seconds=%.6f "
+	       "calls_per_sec=%.1f checksum=%08lx\n", placed, rounds, calls, cast,
+	       seconds, seconds > 0 ? calls / seconds : 0.0,
+	       (unsigned long)checksum);
+	fflush(stdout);
+}
+
+/*
+ * "bench-monsters <turns> [monsters]" replaces the monsters on the level with
+ * up to <monsters> sleeping ones, scattered out of sight, and runs <turns>
+ * game turns of monster processing while the player stands still, making the
+ * noise of a resting character, until something hurts the player.  The
+ * checksum of the monsters' state is for comparing builds run from the same
+ * seed.
+ */
+static void c_bench_monsters(char *rest) {
+	char *arg = strtok(rest ? rest : "", " ");
+	int turns = arg ? atoi(arg) : 1000;
+	int want, placed = 0, tries, n, i, awake = 0;
+	u32b checksum = 0;
+	double start, seconds;
+
+	if (!character_dungeon) return;
+
+	arg = strtok(NULL, " ");
+	want = arg ? atoi(arg) : 200;
+
+	wipe_m_list();
+	for (tries = 0; placed < want && tries < want * 100; tries++) {
+		int y = randint1(DUNGEON_HGT - 2);
+		int x = randint1(DUNGEON_WID - 2);
+		int r_idx = randint1(z_info->r_max - 1);
+		monster_race *r_ptr = &r_info[r_idx];
+
+		if (distance(y, x, p_ptr->py, p_ptr->px) <= 2 * MAX_SIGHT) continue;
+		if (!r_ptr->name || !r_ptr->sleep) continue;
+		if (rf_has(r_ptr->flags, RF_UNIQUE)) continue;
+		if (rf_has(r_ptr->flags, RF_PLAYER_GHOST)) continue;
+		if (!in_bounds_fully(y, x) || !cave_empty_bold(y, x)) continue;
+
+		if (place_monster_aux(y, x, r_idx, TRUE, FALSE))
+			placed++;
+	}
+	update_monsters(TRUE);
+
+	start = bench_now();
+	/* Stop if anything reaches the player */
+	for (n = 0; n < turns && p_ptr->chp == p_ptr->mhp; n++) {
+		total_wakeup_chance = p_ptr->state.base_wakeup_chance / 2;
+		process_monsters(0);
+		reset_monsters();
+		turn++;
+	}
+	seconds = bench_now() - start;
+
+	for (i = 1; i < m_max; i++) {
+		monster_type *m_ptr = &m_list[i];
+
+		if (!m_ptr->r_idx) continue;
+		if (!m_ptr->csleep) awake++;
+		checksum = checksum * 31 + mon_energy(m_ptr);
+		checksum = checksum * 31 + m_ptr->csleep;
+		checksum = checksum * 31 + m_ptr->hp;
+		checksum = checksum * 31 + m_ptr->fy * DUNGEON_WID + m_ptr->fx;
+	}
+
+	printf("bench-monsters placed=%d monsters=%d awake=%d turns=%d "
+	       "seconds=%.6f turns_per_sec=%.1f checksum=%08lx\n", placed,
+	       m_cnt, awake, n, seconds, seconds > 0 ? n / seconds : 0.0,
+	       (unsigned long)checksum);
+	fflush(stdout);
+}
+
+/*
+ * "bench-detect <rounds>" detects the monsters and objects around the player
+ * <rounds> times over, as the spells do, and counts what has been found.
+ */
+static void c_bench_detect(char *rest) {
+	int rounds = rest ? atoi(rest) : 1000;
+	int round, i, monsters = 0, objects = 0;
+	double start, seconds;
+
+	if (!character_dungeon) return;
+
+	start = bench_now();
+	for (round = 0; round < rounds; round++) {
+		(void) detect_monsters_normal(DETECT_RAD_DEFAULT, FALSE);
+		(void) detect_monsters_invis(DETECT_RAD_DEFAULT, FALSE);
+		(void) detect_objects_normal(DETECT_RAD_DEFAULT, FALSE);
+	}
+	seconds = bench_now() - start;
+
+	for (i = 1; i < m_max; i++)
+		if (m_list[i].r_idx && (m_list[i].mflag & (MFLAG_MARK))) monsters++;
+	for (i = 1; i < o_max; i++)
+		if (o_list[i].k_idx && o_list[i].marked) objects++;
+
+	printf("bench-detect rounds=%d monsters=%d objects=%d seconds=%.6f "
+	       "rounds_per_sec=%.1f\n", rounds, monsters, objects, seconds,
+	       seconds > 0 ? rounds / seconds : 0.0);
+	fflush(stdout);
+}
+
+static const char *randart_obj_names[] = {
+	#define OF(a, b) #a,
+	#include "list-object-flags.h"
+	#undef OF
+};
+
+static const char *randart_curse_names[] = {
+	#define CF(a, b) #a,
+	#include "list-curse-flags.h"
+	#undef CF
+};
+
+static void print_randart_counts(const char *kind, const unsigned long *counts,
+                                 int n, const char **names) {
+	int i;
+
+	for (i = 0; i < n; i++) {
+		if (!counts[i]) continue;
+
+		if (names)
+			printf("bench-randart-flag kind=%s name=%s count=%lu\n", kind,
+			       names[i], counts[i]);
+		else
+			printf("bench-randart-flag kind=%s name=%d count=%lu\n", kind, i,
+			       counts[i]);
+	}
+}
+
+/*
+ * "bench-randart <n>" designs n complete sets of random artifacts for the
+ * current character, printing the potential granted and spent and the
+ * qualities of each set, then how often each quality came up over all the
+ * sets.  The game's own random artifacts are put back afterwards.
+ */
+static void c_bench_randart(char *rest) {
+	unsigned long obj[OF_MAX], curse[CF_MAX];
+	unsigned long res[MAX_P_RES], stat[A_MAX], other[MAX_P_BONUS];
+	unsigned long slay[MAX_P_SLAY], brand[MAX_P_BRAND];
+	artifact_type *saved;
+	int *granted, *unspent;
+	int num = rest ? atoi(rest) : 1;
+	long total_granted = 0, total_unspent = 0;
+	double start;
+	int set, a_idx, i;
+
+	if (!character_generated) return;
+
+	memset(obj, 0, sizeof(obj));
+	memset(curse, 0, sizeof(curse));
+	memset(res, 0, sizeof(res));
+	memset(stat, 0, sizeof(stat));
+	memset(other, 0, sizeof(other));
+	memset(slay, 0, sizeof(slay));
+	memset(brand, 0, sizeof(brand));
+
+	granted = C_ZNEW(z_info->a_max, int);
+	unspent = C_ZNEW(z_info->a_max, int);
+
+	/* Keep the real set, giving the batch its own copies of the names */
+	saved = C_ZNEW(z_info->a_max, artifact_type);
+	for (a_idx = ART_MIN_RANDOM; a_idx < z_info->a_max; a_idx++) {
+		saved[a_idx] = a_info[a_idx];
+		a_info[a_idx].name = string_make(saved[a_idx].name);
+	}
+
+	start = bench_now();
+	for (set = 0; set < num; set++) {
+		long set_granted = 0, set_unspent = 0, levels = 0;
+		int qualities = 0, cursed = 0;
+
+		design_random_artifacts(granted, unspent);
+
+		for (a_idx = ART_MIN_RANDOM; a_idx < z_info->a_max; a_idx++) {
+			artifact_type *a_ptr = &a_info[a_idx];
+
+			set_granted += granted[a_idx];
+			set_unspent += unspent[a_idx];
+			levels += a_ptr->level;
+			if (!cf_is_empty(a_ptr->flags_curse)) cursed++;
+
+			for (i = of_next(a_ptr->flags_obj, FLAG_START);
+			     i != FLAG_END && i < OF_MAX; i = of_next(a_ptr->flags_obj, i + 1)) {
+				obj[i]++;
+				qualities++;
+			}
+			for (i = cf_next(a_ptr->flags_curse, FLAG_START);
+			     i != FLAG_END && i < CF_MAX; i = cf_next(a_ptr->flags_curse, i + 1)) {
+				curse[i]++;
+				qualities++;
+			}
+
+			for (i = 0; i < MAX_P_RES; i++)
+				if (a_ptr->percent_res[i] != RES_LEVEL_BASE) {
+					res[i]++;
+					qualities++;
+				}
+			for (i = 0; i < A_MAX; i++)
+				if (a_ptr->bonus_stat[i] != BONUS_BASE) {
+					stat[i]++;
+					qualities++;
+				}
+			for (i = 0; i < MAX_P_BONUS; i++)
+				if (a_ptr->bonus_other[i] != BONUS_BASE) {
+					other[i]++;
+					qualities++;
+				}
+			for (i = 0; i < MAX_P_SLAY; i++)
+				if (a_ptr->multiple_slay[i] != MULTIPLE_BASE) {
+					slay[i]++;
+					qualities++;
+				}
+			for (i = 0; i < MAX_P_BRAND; i++)
+				if (a_ptr->multiple_brand[i] != MULTIPLE_BASE) {
+					brand[i]++;
+					qualities++;
+				}
+		}
+
+		printf("bench-randart-set set=%d artifacts=%d potential=%ld spent=%ld "
+		       "unspent=%ld qualities=%d cursed=%d mean_level=%.1f\n", set,
+		       z_info->a_max - ART_MIN_RANDOM, set_granted,
+		       set_granted - set_unspent, set_unspent, qualities, cursed,
+		       (double)levels / MAX(z_info->a_max - ART_MIN_RANDOM, 1));
+
+		total_granted += set_granted;
+		total_unspent += set_unspent;
+	}
+
+	print_randart_counts("obj", obj, OF_MAX, randart_obj_names);
+	print_randart_counts("curse", curse, CF_MAX, randart_curse_names);
+	print_randart_counts("res", res, MAX_P_RES, NULL);
+	print_randart_counts("stat", stat, A_MAX, NULL);
+	print_randart_counts("bonus", other, MAX_P_BONUS, NULL);
+	print_randart_counts("slay", slay, MAX_P_SLAY, NULL);
+	print_randart_counts("brand", brand, MAX_P_BRAND, NULL);
+
+	printf("bench-randart sets=%d seconds=%.6f potential=%ld spent=%ld "
+	       "unspent=%ld\n", num, bench_now() - start, total_granted,
+	       total_granted - total_unspent, total_unspent);
+	fflush(stdout);
+
+	/* Put the real set back */
+	for (a_idx = ART_MIN_RANDOM; a_idx < z_info->a_max; a_idx++) {
+		string_free(a_info[a_idx].name);
+		a_info[a_idx] = saved[a_idx];
+	}
+
+	FREE(saved);
+	FREE(granted);
+	FREE(unspent);
+}
+
+/*
+ * Time Term_fresh() over <n> frames each of three kinds of change: the whole
+ * screen, the two end cells of each row (so each row's dirty span is wide but
+ * nearly all unchanged), and every other cell of each row.  Counts the
+ * text/wipe hook calls and cells that each refresh hands the frontend.
+ */
+static void c_bench_term(char *rest) {
+	static const char *patterns[] = { "full", "sparse", "stripes" };
+	int frames = rest ? atoi(rest) : 100;
+	int p, f, x, y, w, h;
+
+	Term_get_size(&w, &h);
+	Term_save();
+
+	for (p = 0; p < 3; p++) {
+		double start, seconds;
+
+		/* Start from a screen of white dots */
+		Term_clear();
+		for (y = 0; y < h; y++)
+			for (x = 0; x < w; x++)
+				Term_putch(x, y, TERM_WHITE, L'.');
+		Term_fresh();
+		term_calls = term_cells = 0;
+
+		start = bench_now();
+		for (f = 0; f < frames; f++) {
+			int a = 1 + (f % 15);
+
+			switch (p) {
+				case 0:
+					for (y = 0; y < h; y++)
+						for (x = 0; x < w; x++)
+							Term_putch(x, y, a, L'a' + (x + y + f) % 26);
+					break;
+
+				case 1:
+					for (y = 0; y < h; y++) {
+						Term_putch(0, y, a, L'a' + f % 26);
+						Term_putch(w - 1, y, a, L'a' + f % 26);
+					}
+					break;
+
+				case 2:
+					for (y = 0; y < h; y++)
+						for (x = 0; x < w; x += 2)
+							Term_putch(x, y, TERM_WHITE, (f & 1) ? L'+' : L'x');
+					break;
+			}
+
+			Term_fresh();
+		}
+		seconds = bench_now() - start;
+
+		printf("bench-term pattern=%s frames=%d seconds=%f us_per_frame=%.2f "
+			   "hook_calls=%lu cells=%lu\n", patterns[p], frames, seconds,
+			   frames ? seconds * 1000000.0 / frames : 0.0, term_calls,
+			   term_cells);
+	}
+
+	/* Put the screen back */
+	Term_load();
+	Term_fresh();
+}
+
+/*
+ * "bench-map <n>" times n redraws of the map as display_map() keeps it,
+ * with a grid near the player changing each time, then n redraws of the
+ * whole map worked out afresh.  The kept map and the fresh one must show
+ * the same, which is worth checking between moves of a script.
+ */
+static void c_bench_map(char *rest) {
+	int n = rest ? atoi(rest) : 100;
+	int w, h, x, y, i, diff = 0;
+	double start, incremental, full;
+	int **a;
+	wchar_t **c;
+
+	if (!character_dungeon) return;
+
+	Term_get_size(&w, &h);
+	Term_save();
+	Term_clear();
+
+	start = bench_now();
+	for (i = 0; i < n; i++) {
+		light_spot(p_ptr->py, p_ptr->px + (i % 3) - 1);
+		display_map_changes();
+	}
+	incremental = bench_now() - start;
+
+	/* Remember what the kept map shows */
+	Term_clear();
+	display_map(NULL, NULL);
+	a = mem_zalloc(h * sizeof(int *));
+	c = mem_zalloc(h * sizeof(wchar_t *));
+	for (y = 0; y < h; y++) {
+		a[y] = mem_zalloc(w * sizeof(int));
+		c[y] = mem_zalloc(w * sizeof(wchar_t));
+		for (x = 0; x < w; x++) {
+			a[y][x] = Term->scr->a[y][x];
+			c[y][x] = Term->scr->c[y][x];
+		}
+	}
+
+	start = bench_now();
+	for (i = 0; i < n; i++) {
+		display_map_note(-1, -1);
+		Term_clear();
+		display_map(NULL, NULL);
+	}
+	full = bench_now() - start;
+
+	for (y = 0; y < h; y++) {
+		for (x = 0; x < w; x++)
+			if ((a[y][x] != Term->scr->a[y][x]) || (c[y][x] != Term->scr->c[y][x]))
+				diff++;
+		mem_free(a[y]);
+		mem_free(c[y]);
+	}
+	mem_free(a);
+	mem_free(c);
+
+	printf("bench-map redraws=%d incremental_seconds=%.6f full_seconds=%.6f "
+	       "differences=%d\n", n, incremental, full, diff);
+	fflush(stdout);
+
+	Term_load();
+}
+
+/*
+ * "bench-glyphs <n>" times n redraws of the map panel from the glyphs kept
+ * by map_glyph(), then n with them forgotten first, and counts the grids
+ * whose kept glyph differs from what map_info() says now.
+ */
+static void c_bench_glyphs(char *rest) {
+	int n = rest ? atoi(rest) : 100;
+	int y, x, i, diff = 0;
+	double start, kept, fresh;
+
+	if (!character_dungeon) return;
+
+	start = bench_now();
+	for (i = 0; i < n; i++)
+		prt_map();
+	kept = bench_now() - start;
+
+	for (y = 0; y < DUNGEON_HGT; y++) {
+		for (x = 0; x < DUNGEON_WID; x++) {
+			grid_data g;
+			int a, ka;
+			byte ta, kta;
+			wchar_t c, tc, kc, ktc;
+
+			map_glyph(y, x, &ka, &kc, &kta, &ktc);
+			map_info(y, x, &g);
+			grid_data_as_text(&g, &a, &c, &ta, &tc);
+			if ((a != ka) || (c != kc) || (ta != kta) || (tc != ktc))
+				diff++;
+		}
+	}
+
+	start = bench_now();
+	for (i = 0; i < n; i++) {
+		forget_map_glyphs();
+		prt_map();
+	}
+	fresh = bench_now() - start;
+
+	printf("bench-glyphs redraws=%d kept_seconds=%.6f fresh_seconds=%.6f "
+	       "differences=%d\n", n, kept, fresh, diff);
+	fflush(stdout);
 }
 
 typedef struct {
@@ -133,7 +1302,9 @@ typedef struct {
 static test_cmd cmds[] = {
 	{ "#", c_noop },
 	{ "key", c_key },
+	{ "keys", c_keys },
 	{ "noop", c_noop },
+	{ "option", c_option },
 	{ "quit", c_quit },
 	{ "verbose", c_verbose },
 	{ "version?", c_version },
@@ -142,10 +1313,38 @@ static test_cmd cmds[] = {
 	{ "player-class?", c_player_class },
 	{ "player-race?", c_player_race },
 	{ "player-sex?", c_player_sex },
+	{ "player-heal", c_player_heal },
+	{ "player-wound", c_player_wound },
+	{ "player-exp", c_player_exp },
+
+	{ "seed", c_seed },
+	{ "stage", c_stage },
+	{ "summon", c_summon },
+	{ "check-project", c_check_project },
+	{ "check-regions", c_check_regions },
+
+	{ "bench-phase", c_bench_phase },
+	{ "bench-report", c_bench_report },
+	{ "bench-gen", c_bench_gen },
+	{ "bench-prepare", c_bench_prepare },
+	{ "bench-spell", c_bench_spell },
+	{ "bench-monsters", c_bench_monsters },
+	{ "bench-detect", c_bench_detect },
+	{ "bench-randart", c_bench_randart },
+	{ "bench-term", c_bench_term },
+	{ "bench-map", c_bench_map },
+	{ "bench-glyphs", c_bench_glyphs },
 
 	{ NULL, NULL }
 };
 
+/*
+ * "repeat <n> <command>" behaves like n copies of the command line, so each
+ * copy is run the next time the game waits for a key.
+ */
+static char repeat_line[1024];
+static int repeat_left = 0;
+
 static errr test_docmd(void) {
 	char buf[1024];
 	char *cmd;
@@ -154,15 +1353,41 @@ static errr test_docmd(void) {
 
 	memset(buf, 0, sizeof(buf));
 
-	if (prompt) {
-		printf("test> ");
-		fflush(stdout);
-	}
-	if (!fgets(buf, sizeof(buf), stdin)) {
-		return -1;
+	/* A dead character can't carry on with the script */
+	if (character_generated && p_ptr->is_dead) {
+		bench_report();
+		quit(NULL);
 	}
-	if (strchr(buf, '\n')) {
-		*strchr(buf, '\n') = '\0';
+
+	if (repeat_left) {
+		repeat_left--;
+		my_strcpy(buf, repeat_line, sizeof(buf));
+	} else {
+		if (prompt) {
+			printf("test> ");
+			fflush(stdout);
+		}
+		if (!fgets(buf, sizeof(buf), stdin)) {
+			/* End of script */
+			bench_report();
+			quit(NULL);
+		}
+		if (strchr(buf, '\n')) {
+			*strchr(buf, '\n') = '\0';
+		}
+
+		if (!strncmp(buf, "repeat ", 7)) {
+			char *line = strchr(buf + 7, ' ');
+
+			if (!line) return 0;
+			repeat_left = atoi(buf + 7) - 1;
+			if (repeat_left < 0) {
+				repeat_left = 0;
+				return 0;
+			}
+			my_strcpy(repeat_line, line + 1, sizeof(repeat_line));
+			my_strcpy(buf, repeat_line, sizeof(buf));
+		}
 	}
 
 	if (verbose) printf("test-docmd: %s\n", buf);
@@ -224,13 +1449,23 @@ static errr term_xtra_alive(int v) {
 	return 0;
 }
 
+/*
+ * Hand over one queued key, or read script lines until there is one.  Polls
+ * that don't wait (disturbance checks while resting or running) never read
+ * the script, so a replay doesn't depend on how often the game polls.
+ */
 static errr term_xtra_event(int v) {
 	if (verbose) printf("term-xtra-event %d\n", v);
-	if (nextkey) {
-		Term_keypress(nextkey, 0);
-		nextkey = 0;
+
+	while (keyq_head == keyq_tail) {
+		if (!v) return 0;
+		test_docmd();
 	}
-	return test_docmd();
+
+	Term_keypress(keyq[keyq_tail], 0);
+	keyq_tail = (keyq_tail + 1) % KEYQ_SIZE;
+
+	return 0;
 }
 
 static errr term_xtra_flush(int v) {
@@ -278,14 +1513,28 @@ static errr term_curs_test(int x, int y) {
 }
 
 static errr term_wipe_test(int x, int y, int n) {
+	term_calls++;
+	term_cells += n;
 	if (verbose) printf("term-wipe %d %d %d\n", x, y, n);
 	return 0;
 }
 
 static errr term_text_test(int x, int y, int n, int a, const wchar_t *s) {
+	term_calls++;
+	term_cells += n;
 	if (verbose) {
-		char str[256];
-		wcstombs(str, s, 256);
+		char str[1024];
+		wchar_t buf[256];
+		size_t len;
+
+		/* The text isn't terminated, and may be followed by more */
+		if (n > 255) n = 255;
+		memcpy(buf, s, n * sizeof(wchar_t));
+		buf[n] = 0;
+
+		len = wcstombs(str, buf, sizeof(str) - 1);
+		str[len == (size_t)-1 ? 0 : len] = '\0';
+
 		printf("term-text %d %d %d %02x %s\n", x, y, n, a, str);
 	}
 	return 0;
@@ -311,7 +1560,7 @@ static void term_data_link(int i) {
 	angband_term[i] = t;
 }
 
-const char help_test[] = "Test mode, subopts -p(rompt)";
+const char help_test[] = "Test mode, subopts -p(rompt) -v(erbose)";
 
 errr init_test(int argc, char *argv[]) {
 	int i;
@@ -322,6 +1571,10 @@ errr init_test(int argc, char *argv[]) {
 			prompt = 1;
 			continue;
 		}
+		if (!strcmp(argv[i], "-v")) {
+			verbose = 1;
+			continue;
+		}
 		printf("init-test: bad argument '%s'\n", argv[i]);
 	}
 
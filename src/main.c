@@ -56,6 +56,7 @@ static const struct module modules[] =
 
 #ifdef USE_TEST
 	{ "test", help_test, init_test },
+	{ "null", help_null, init_null },
 #endif /* !USE_TEST */
 
 #ifdef USE_STATS
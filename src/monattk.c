@@ -3383,15 +3383,15 @@ bool make_attack_ranged(monster_type * m_ptr, int attack)
 			}
 
 			/* Allow a quick speed increase if not already greatly hasted. */
-			if (m_ptr->mspeed < r_ptr->speed + 10) {
+			if (mon_speed(m_ptr) < r_ptr->speed + 10) {
 				msg("%s starts moving faster.", m_name);
-				m_ptr->mspeed += 10;
+				mon_speed(m_ptr) += 10;
 			}
 
 			/* Allow small speed increases to base+20 */
-			else if (m_ptr->mspeed < r_ptr->speed + 20) {
+			else if (mon_speed(m_ptr) < r_ptr->speed + 20) {
 				msg("%s starts moving slightly faster.", m_name);
-				m_ptr->mspeed += 2;
+				mon_speed(m_ptr) += 2;
 			}
 
 			break;
@@ -3542,10 +3542,10 @@ bool make_attack_ranged(monster_type * m_ptr, int attack)
 			}
 
 			/* Cancel (major) slowing */
-			if ((m_ptr->mspeed < r_ptr->speed - 5)
+			if ((mon_speed(m_ptr) < r_ptr->speed - 5)
 				&& !(m_ptr->black_breath)) {
 				/* Cancel slowing */
-				m_ptr->mspeed = r_ptr->speed;
+				mon_speed(m_ptr) = r_ptr->speed;
 
 				/* Message */
 				if (seen)
@@ -120,7 +120,7 @@ static void find_range(monster_type * m_ptr)
 	/* Nearby monsters that cannot run away will not become run unless
 	 * completely afraid */
 	else if ((m_ptr->cdis < TURN_RANGE) &&
-			 (m_ptr->mspeed < p_ptr->state.pspeed))
+			 (mon_speed(m_ptr) < p_ptr->state.pspeed))
 		m_ptr->min_range = 1;
 
 	/* Now find prefered range */
@@ -761,8 +761,121 @@ static int find_resist(int m_idx, int spell_lrn)
 	}
 }
 
-/* Temporary spell flags */
-static bitflag mon_spells[RSF_SIZE];
+/**
+ * The spells each race can cast, as lists in increasing spell order, for
+ * each of the situations that decide which spells can be used at all.
+ */
+enum {
+	SPELLS_CLEAR,				/* Clean shot at the target */
+	SPELLS_NOT_CLEAR,			/* Target in view, but no clean shot */
+	SPELLS_NO_LOS,				/* Target out of view */
+	SPELLS_ARCHERY,				/* Archery only, with a clean shot */
+	SPELLS_MAX
+};
+
+typedef struct race_spells {
+	bitflag flags[RSF_SIZE];	/* Racial spells the lists were built from */
+	byte *list[SPELLS_MAX];
+	byte num[SPELLS_MAX];
+} race_spells;
+
+static race_spells *race_spell_info;
+
+/* Spells needing special treatment when rated */
+static bitflag breath_spells[RSF_SIZE];
+static bitflag harass_spells[RSF_SIZE];
+
+/**
+ * Build the spell lists for one race.
+ */
+static void build_race_spells(int r_idx)
+{
+	monster_race *r_ptr = &r_info[r_idx];
+	race_spells *rs = &race_spell_info[r_idx];
+	bitflag usable[SPELLS_MAX][RSF_SIZE];
+	int i, j;
+
+	rsf_copy(rs->flags, r_ptr->spell_flags);
+
+	rsf_copy(usable[SPELLS_CLEAR], r_ptr->spell_flags);
+
+	rsf_copy(usable[SPELLS_NOT_CLEAR], r_ptr->spell_flags);
+	flags_clear(usable[SPELLS_NOT_CLEAR], RSF_SIZE, RSF_BOLT_MASK, FLAG_END);
+
+	rsf_copy(usable[SPELLS_NO_LOS], r_ptr->spell_flags);
+	flags_mask(usable[SPELLS_NO_LOS], RSF_SIZE, RSF_NO_PLAYER_MASK, FLAG_END);
+
+	rsf_copy(usable[SPELLS_ARCHERY], r_ptr->spell_flags);
+	flags_mask(usable[SPELLS_ARCHERY], RSF_SIZE, RSF_ARCHERY_MASK, FLAG_END);
+
+	for (j = 0; j < SPELLS_MAX; j++) {
+		FREE(rs->list[j]);
+		rs->num[j] = 0;
+
+		for (i = rsf_next(usable[j], FLAG_START); i != FLAG_END && i < RSF_MAX;
+			 i = rsf_next(usable[j], i + 1))
+			rs->num[j]++;
+
+		if (!rs->num[j])
+			continue;
+
+		rs->list[j] = C_ZNEW(rs->num[j], byte);
+		rs->num[j] = 0;
+
+		for (i = rsf_next(usable[j], FLAG_START); i != FLAG_END && i < RSF_MAX;
+			 i = rsf_next(usable[j], i + 1))
+			rs->list[j][rs->num[j]++] = i;
+	}
+}
+
+/**
+ * Build the spell lists for every race.
+ */
+void init_race_spells(void)
+{
+	int r_idx;
+
+	flags_init(breath_spells, RSF_SIZE, RSF_BREATH_MASK, FLAG_END);
+	flags_init(harass_spells, RSF_SIZE, RSF_HARASS_MASK, FLAG_END);
+
+	race_spell_info = C_ZNEW(z_info->r_max, race_spells);
+
+	for (r_idx = 1; r_idx < z_info->r_max; r_idx++)
+		build_race_spells(r_idx);
+}
+
+void free_race_spells(void)
+{
+	int r_idx, j;
+
+	if (!race_spell_info)
+		return;
+
+	for (r_idx = 0; r_idx < z_info->r_max; r_idx++)
+		for (j = 0; j < SPELLS_MAX; j++)
+			FREE(race_spell_info[r_idx].list[j]);
+
+	FREE(race_spell_info);
+}
+
+/**
+ * Get a copy of the spells a race can use in a situation, rebuilding the
+ * lists first if the racial spells have changed, as a player ghost's do.
+ *
+ * Returns the number of spells copied.
+ */
+static int get_race_spells(int r_idx, int situation, byte *spells)
+{
+	race_spells *rs = &race_spell_info[r_idx];
+
+	if (!rsf_is_equal(rs->flags, r_info[r_idx].spell_flags))
+		build_race_spells(r_idx);
+
+	if (rs->num[situation])
+		memcpy(spells, rs->list[situation], rs->num[situation]);
+
+	return rs->num[situation];
+}
 
 
 /**
@@ -773,14 +886,16 @@ static bitflag mon_spells[RSF_SIZE];
  * Smart monsters may also exclude spells that use a lot of mana,
  * even if they have enough.
  *
+ * Returns the number of spells left.
+ *
  * -BR-
  */
-static void remove_expensive_spells(int m_idx)
+static int remove_expensive_spells(int m_idx, byte *spells, int num)
 {
 	monster_type *m_ptr = &m_list[m_idx];
 	monster_race *r_ptr = &r_info[m_ptr->r_idx];
 
-	int i, max_cost;
+	int i, left, max_cost;
 
 	/* Determine maximum amount of mana to be spent */
 	/* Smart monsters will usually not blow all their mana on one spell */
@@ -792,55 +907,70 @@ static void remove_expensive_spells(int m_idx)
 		max_cost = m_ptr->mana;
 
 	/* check innate spells for mana available */
-	for (i = FLAG_START; i < RSF_MAX; i++) {
-		if (mana_cost[i] > max_cost)
-			(void) rsf_off(mon_spells, i);
+	for (i = 0, left = 0; i < num; i++) {
+		if (mana_cost[spells[i]] <= max_cost)
+			spells[left++] = spells[i];
 	}
+
+	return left;
 }
 
 /**
  * Intellegent monsters use this function to filter away spells
  * which have no benefit.
+ *
+ * Returns the number of spells left.
  */
-static void remove_useless_spells(int m_idx, bool los)
+static int remove_useless_spells(int m_idx, bool los, byte *spells, int num)
 {
 	monster_type *m_ptr = &m_list[m_idx];
 	monster_race *r_ptr = &r_info[m_ptr->r_idx];
+	bitflag useless[RSF_SIZE];
+	int i, left;
+
+	rsf_wipe(useless);
 
 	/* Don't regain mana if full */
 	if (m_ptr->mana >= r_ptr->mana)
-		rsf_off(mon_spells, RSF_ADD_MANA);
+		rsf_on(useless, RSF_ADD_MANA);
 
 	/* Don't heal if not enough mana to make it useful */
 	if (m_ptr->mana < r_ptr->spell_power / 4)
-		rsf_off(mon_spells, RSF_HEAL);
+		rsf_on(useless, RSF_HEAL);
 
 	/* Don't heal if full */
 	if (m_ptr->hp >= m_ptr->maxhp)
-		rsf_off(mon_spells, RSF_HEAL);
+		rsf_on(useless, RSF_HEAL);
 
 	/* Don't lash if too far or close */
 	if ((m_ptr->cdis > 3) || (m_ptr->cdis < 2))
-		rsf_off(mon_spells, RSF_LASH);
+		rsf_on(useless, RSF_LASH);
 
 	/* Don't Haste if Hasted */
-	if (m_ptr->mspeed > r_ptr->speed + 5)
-		rsf_off(mon_spells, RSF_HASTE);
+	if (mon_speed(m_ptr) > r_ptr->speed + 5)
+		rsf_on(useless, RSF_HASTE);
 
 	/* Don't cure if not needed */
 	if (!((m_ptr->stunned) || (m_ptr->monfear)
-		  || (m_ptr->mspeed < r_ptr->speed - 5) || (m_ptr->black_breath)))
-		rsf_off(mon_spells, RSF_CURE);
+		  || (mon_speed(m_ptr) < r_ptr->speed - 5) || (m_ptr->black_breath)))
+		rsf_on(useless, RSF_CURE);
 
 	/* Don't jump in already close, or don't want to be close */
 	if (!(m_ptr->cdis > m_ptr->best_range) && los)
-		rsf_off(mon_spells, RSF_TELE_SELF_TO);
+		rsf_on(useless, RSF_TELE_SELF_TO);
 	if (m_ptr->min_range > 5)
-		rsf_off(mon_spells, RSF_TELE_SELF_TO);
+		rsf_on(useless, RSF_TELE_SELF_TO);
+
+	for (i = 0, left = 0; i < num; i++) {
+		if (!rsf_has(useless, spells[i]))
+			spells[left++] = spells[i];
+	}
+
+	return left;
 }
 
 /**
- * Count the number of castable spells.
+ * Choose from the castable spells without any AI.
  *
  * If exactly 1 spell is availble cast it.  If more than more is
  * available, and the random bit is set, pick one.
@@ -851,17 +981,9 @@ static void remove_useless_spells(int m_idx, bool los)
  * Also used in 'choose_attack_spell' to circumvent AI when 
  * casting randomly (random=TRUE), as with dumb monsters.
  */
-static int choose_attack_spell_fast(int m_idx, bool random)
+static int choose_attack_spell_fast(int m_idx, const byte *spells, int num,
+									bool random)
 {
-	int i, num = 0;
-	byte spells[32 * RSF_SIZE];
-
-	/* Extract all spells: "innate", "normal", "bizarre" */
-	for (i = FLAG_START, num = 0; i < RSF_MAX; i++) {
-		if (rsf_has(mon_spells, i))
-			spells[num++] = i;
-	}
-
 	/* Paranoia */
 	if (num == 0)
 		return 0;
@@ -924,7 +1046,7 @@ int choose_ranged_attack(int m_idx, bool archery_only, int shape_rate)
 	bool is_best_harass = FALSE;
 	bool is_breath = FALSE;
 
-	int i, py = p_ptr->py, px = p_ptr->px, ty, tx;
+	int i, j, py = p_ptr->py, px = p_ptr->px, ty, tx;
 	int breath_hp, breath_maxhp, path, spaces;
 
 	int want_hps = 0, want_escape = 0, want_mana = 0, want_summon = 0;
@@ -933,9 +1055,8 @@ int choose_ranged_attack(int m_idx, bool archery_only, int shape_rate)
 	int best_spell = 0, best_spell_rating = 0;
 	int cur_spell_rating;
 
-	/* Extract the racial spell flags f4 = r_ptr->flags4; f5 = r_ptr->flags5;
-	 * f6 = r_ptr->flags6; f7 = r_ptr->flags7; */
-	rsf_copy(mon_spells, r_ptr->spell_flags);
+	byte spells[RSF_MAX];
+	int num;
 
 	/* Player is the target */
 	if (m_ptr->hostile < 0) {
@@ -952,7 +1073,10 @@ int choose_ranged_attack(int m_idx, bool archery_only, int shape_rate)
 		return (0);
 
 	/* Check what kinds of spells can hit target */
-	path = projectable(m_ptr->fy, m_ptr->fx, ty, tx, PROJECT_CHCK);
+	if (m_ptr->hostile < 0)
+		path = projectable_player(m_ptr->fy, m_ptr->fx, PROJECT_CHCK);
+	else
+		path = projectable(m_ptr->fy, m_ptr->fx, ty, tx, PROJECT_CHCK);
 
 	/* do we have the target in sight at all? */
 	if (path == PROJECT_NO) {
@@ -974,41 +1098,42 @@ int choose_ranged_attack(int m_idx, bool archery_only, int shape_rate)
 			return (0);
 
 		/* restrict to archery */
-		flags_mask(mon_spells, RSF_SIZE, RSF_ARCHERY_MASK, FLAG_END);
+		num = get_race_spells(m_ptr->r_idx, SPELLS_ARCHERY, spells);
 
 		/* choose at random from restricted list */
-		return (choose_attack_spell_fast(m_idx, TRUE));
+		return (choose_attack_spell_fast(m_idx, spells, num, TRUE));
 	}
 
 	/* Remove spells the 'no-brainers' */
 	/* Spells that require LOS */
-	if (!los) {
-		flags_mask(mon_spells, RSF_SIZE, RSF_NO_PLAYER_MASK, FLAG_END);
-	} else if (path == PROJECT_NOT_CLEAR) {
-		flags_clear(mon_spells, RSF_SIZE, RSF_BOLT_MASK, FLAG_END);
-	}
+	if (!los)
+		num = get_race_spells(m_ptr->r_idx, SPELLS_NO_LOS, spells);
+	else if (path == PROJECT_NOT_CLEAR)
+		num = get_race_spells(m_ptr->r_idx, SPELLS_NOT_CLEAR, spells);
+	else
+		num = get_race_spells(m_ptr->r_idx, SPELLS_CLEAR, spells);
 
 	/* No spells left */
-	if (rsf_is_empty(mon_spells))
+	if (!num)
 		return (0);
 
 	/* Spells we can not afford */
-	remove_expensive_spells(m_idx);
+	num = remove_expensive_spells(m_idx, spells, num);
 
 	/* No spells left */
-	if (rsf_is_empty(mon_spells))
+	if (!num)
 		return (0);
 
 	/* Stupid monsters choose at random. */
 	if (rf_has(r_ptr->flags, RF_STUPID))
-		return (choose_attack_spell_fast(m_idx, TRUE));
+		return (choose_attack_spell_fast(m_idx, spells, num, TRUE));
 
 	/* Remove spells that have no benefit Does not include the effects of
 	 * player resists/immunities */
-	remove_useless_spells(m_idx, los);
+	num = remove_useless_spells(m_idx, los, spells, num);
 
 	/* No spells left */
-	if (rsf_is_empty(mon_spells))
+	if (!num)
 		return (0);
 
 	/* Sometimes non-dumb monsters cast randomly (though from the restricted
@@ -1021,7 +1146,7 @@ int choose_ranged_attack(int m_idx, bool archery_only, int shape_rate)
 	/* Try 'fast' selection first. If there is only one spell, choose that
 	 * spell. If there are multiple spells, choose one randomly if the 'rand'
 	 * flag is set. Otherwise fail, and let the AI choose. */
-	best_spell = choose_attack_spell_fast(m_idx, rand);
+	best_spell = choose_attack_spell_fast(m_idx, spells, num, rand);
 	if (best_spell)
 		return (best_spell);
 
@@ -1074,20 +1199,14 @@ int choose_ranged_attack(int m_idx, bool archery_only, int shape_rate)
 		update_smart_cheat(m_idx);
 
 	/* Now check every remaining spell */
-	for (i = FLAG_START; i < RSF_MAX; i++) {
-		bitflag temp[RSF_SIZE];
-
-		/* Do we even have this spell? */
-		if (!rsf_has(mon_spells, i))
-			continue;
+	for (j = 0; j < num; j++) {
+		i = spells[j];
 
 		/* Is it a breath? */
-		flags_init(temp, RSF_SIZE, RSF_BREATH_MASK, FLAG_END);
-		is_breath = rsf_has(temp, i);
+		is_breath = rsf_has(breath_spells, i);
 
 		/* Is it a harassing spell? */
-		flags_init(temp, RSF_SIZE, RSF_HARASS_MASK, FLAG_END);
-		is_harass = rsf_has(temp, i);
+		is_harass = rsf_has(harass_spells, i);
 
 		/* Base Desirability */
 		cur_spell_rating = spell_desire[i][D_RES];
@@ -2289,7 +2408,7 @@ static bool get_move(monster_type * m_ptr, int *ty, int *tx, bool * fear,
 	if (*fear) {
 		/* The character is too close to avoid, and faster than we are */
 		if ((!m_ptr->monfear) && (m_ptr->cdis < TURN_RANGE)
-			&& (p_ptr->state.pspeed > m_ptr->mspeed)) {
+			&& (p_ptr->state.pspeed > mon_speed(m_ptr))) {
 			/* Recalculate range */
 			find_range(m_ptr);
 
@@ -2493,7 +2612,9 @@ static bool get_move(monster_type * m_ptr, int *ty, int *tx, bool * fear,
 			}
 
 			/* Monsters that can't target the character will advance. */
-			else if (projectable(m_ptr->fy, m_ptr->fx, targ_y, targ_x, 0)
+			else if (((m_ptr->hostile < 0) ?
+					  projectable_player(m_ptr->fy, m_ptr->fx, 0) :
+					  projectable(m_ptr->fy, m_ptr->fx, targ_y, targ_x, 0))
 					 == PROJECT_NO) {
 				*ty = targ_y;
 				*tx = targ_x;
@@ -3952,7 +4073,7 @@ static void process_move(monster_type * m_ptr, int ty, int tx, bool bash)
 
 		/* Check for runes of speed, slow if not slowed already */
 		if (cave_trap_specific(ny, nx, RUNE_SPEED)
-			&& (m_ptr->mspeed > r_ptr->speed - 5)) {
+			&& (mon_speed(m_ptr) > r_ptr->speed - 5)) {
 			char m_name[80];
 
 			/* Get the monster name */
@@ -3965,7 +4086,7 @@ static void process_move(monster_type * m_ptr, int ty, int tx, bool bash)
 			} else {
 				if (m_ptr->ml)
 					msg("%s starts moving slower.", m_name);
-				m_ptr->mspeed -= 10;
+				mon_speed(m_ptr) -= 10;
 			}
 		}
 
@@ -4276,7 +4397,7 @@ static void process_monster(monster_type * m_ptr)
 		}
 
 		/* Add the energy */
-		m_ptr->energy += (5 - i);
+		mon_energy(m_ptr) += (5 - i);
 
 		/* If target is too far away from home, go back */
 		if (distance(m_ptr->y_terr, m_ptr->x_terr, m_ptr->ty, m_ptr->tx) >
@@ -4618,6 +4739,78 @@ static void process_monster(monster_type * m_ptr)
 }
 
 
+/**
+ * Monster regeneration of HPs, every 100 game turns.
+ */
+static void regen_monster_hp(monster_type * m_ptr)
+{
+	monster_race *r_ptr = &r_info[m_ptr->r_idx];
+
+	int frac;
+
+	if (m_ptr->hp >= m_ptr->maxhp)
+		return;
+
+	/* Base regeneration */
+	frac = m_ptr->maxhp / 100;
+
+	/* Minimal regeneration rate */
+	if (!frac)
+		frac = 1;
+
+	/* Some monsters regenerate quickly */
+	if (rf_has(r_ptr->flags, RF_REGENERATE))
+		frac *= 2;
+
+	/* Regenerate */
+	m_ptr->hp += frac;
+
+	/* Do not over-regenerate */
+	if (m_ptr->hp > m_ptr->maxhp)
+		m_ptr->hp = m_ptr->maxhp;
+
+	/* Fully healed -> flag minimum range for recalculation */
+	if (m_ptr->hp == m_ptr->maxhp)
+		m_ptr->min_range = 0;
+}
+
+
+/**
+ * Check whether recovery could do anything to a sleeping monster beyond
+ * regenerating its hitpoints; if not, it is dormant until the next time.
+ *
+ * This mirrors the tests in recover_monster(), and has to be kept in step
+ * with it.
+ */
+static bool monster_is_dormant(monster_type * m_ptr)
+{
+	monster_race *r_ptr = &r_info[m_ptr->r_idx];
+	int scan_range = (MODE(SMALL_DEVICE) ? r_ptr->aaf / 2 : r_ptr->aaf);
+
+	/* Only sleeping monsters */
+	if (!m_ptr->csleep || m_ptr->stasis)
+		return (FALSE);
+
+	/* Out of range of the character's noise */
+	if (m_ptr->cdis <= scan_range)
+		return (FALSE);
+	if ((add_wakeup_chance > 0) && player_has_los_bold(m_ptr->fy, m_ptr->fx))
+		return (FALSE);
+
+	/* Nothing to recover from */
+	if (m_ptr->black_breath || m_ptr->stunned || m_ptr->confused ||
+		m_ptr->schange || m_ptr->monfear)
+		return (FALSE);
+	if (m_ptr->mana < r_ptr->mana)
+		return (FALSE);
+	if ((mon_speed(m_ptr) > r_ptr->speed + 4)
+		|| (mon_speed(m_ptr) < r_ptr->speed - 4))
+		return (FALSE);
+
+	return (TRUE);
+}
+
+
 /**
  * Monster regeneration of HPs and mana, and recovery from all temporary 
  * conditions.
@@ -4629,7 +4822,6 @@ static void recover_monster(monster_type * m_ptr, bool regen)
 	monster_race *r_ptr = &r_info[m_ptr->r_idx];
 	monster_lore *l_ptr = &l_list[m_ptr->r_idx];
 
-	int frac;
 	int scan_range = (MODE(SMALL_DEVICE) ? r_ptr->aaf / 2 : r_ptr->aaf);
 
 	/* Handle stasis */
@@ -4667,8 +4859,8 @@ static void recover_monster(monster_type * m_ptr, bool regen)
 			return;
 
 		/* Monster gets its bearings */
-		else if (m_ptr->energy > p_ptr->energy)
-			m_ptr->energy = p_ptr->energy;
+		else if (mon_energy(m_ptr) > p_ptr->energy)
+			mon_energy(m_ptr) = p_ptr->energy;
 	}
 
 
@@ -4714,29 +4906,8 @@ static void recover_monster(monster_type * m_ptr, bool regen)
 		 * Allow hp regeneration, if needed, unless suffering from 
 		 * the Black Breath.
 		 */
-		if ((m_ptr->hp < m_ptr->maxhp) && (!m_ptr->black_breath)) {
-			/* Base regeneration */
-			frac = m_ptr->maxhp / 100;
-
-			/* Minimal regeneration rate */
-			if (!frac)
-				frac = 1;
-
-			/* Some monsters regenerate quickly */
-			if (rf_has(r_ptr->flags, RF_REGENERATE))
-				frac *= 2;
-
-			/* Regenerate */
-			m_ptr->hp += frac;
-
-			/* Do not over-regenerate */
-			if (m_ptr->hp > m_ptr->maxhp)
-				m_ptr->hp = m_ptr->maxhp;
-
-			/* Fully healed -> flag minimum range for recalculation */
-			if (m_ptr->hp == m_ptr->maxhp)
-				m_ptr->min_range = 0;
-		}
+		if (!m_ptr->black_breath)
+			regen_monster_hp(m_ptr);
 	}
 
 
@@ -4803,8 +4974,8 @@ static void recover_monster(monster_type * m_ptr, bool regen)
 				}
 
 				/* Monster gets its bearings */
-				if (m_ptr->energy > p_ptr->energy)
-					m_ptr->energy = p_ptr->energy;
+				if (mon_energy(m_ptr) > p_ptr->energy)
+					mon_energy(m_ptr) = p_ptr->energy;
 			}
 		}
 	}
@@ -4851,8 +5022,8 @@ static void recover_monster(monster_type * m_ptr, bool regen)
 				}
 
 				/* Monster gets its bearings */
-				if (m_ptr->energy > p_ptr->energy)
-					m_ptr->energy = p_ptr->energy;
+				if (mon_energy(m_ptr) > p_ptr->energy)
+					mon_energy(m_ptr) = p_ptr->energy;
 			}
 		}
 	}
@@ -4999,17 +5170,17 @@ static void recover_monster(monster_type * m_ptr, bool regen)
 	 * Handle significantly hasted or slowed creatures.  Random variations 
 	 * are not large enough to activate this code.
 	 */
-	if ((m_ptr->mspeed > r_ptr->speed + 4)
-		|| (m_ptr->mspeed < r_ptr->speed - 4)) {
+	if ((mon_speed(m_ptr) > r_ptr->speed + 4)
+		|| (mon_speed(m_ptr) < r_ptr->speed - 4)) {
 		int speedup_chance = 67 - (2 * r_ptr->level / 3);
 
 		/* 
 		 * 1.5% - 3.0% chance (depending on level) that slowed monsters
 		 * will return to normal speed.
 		 */
-		if ((m_ptr->mspeed < r_ptr->speed)
+		if ((mon_speed(m_ptr) < r_ptr->speed)
 			&& (randint0(67) == speedup_chance)) {
-			m_ptr->mspeed = r_ptr->speed;
+			mon_speed(m_ptr) = r_ptr->speed;
 
 			/* Visual note */
 			if (m_ptr->ml) {
@@ -5024,8 +5195,8 @@ static void recover_monster(monster_type * m_ptr, bool regen)
 		}
 
 		/* 1% chance that hasted monsters will return to normal speed. */
-		else if ((m_ptr->mspeed > r_ptr->speed) && (randint0(100) == 0)) {
-			m_ptr->mspeed = r_ptr->speed;
+		else if ((mon_speed(m_ptr) > r_ptr->speed) && (randint0(100) == 0)) {
+			mon_speed(m_ptr) = r_ptr->speed;
 
 			/* Visual note */
 			if (m_ptr->ml) {
@@ -5066,10 +5237,17 @@ void process_monsters(byte minimum_energy)
 	int i;
 	monster_type *m_ptr;
 
+	/* The sweep works on the scheduling arrays */
+	bool *live = m_hot.live;
+	bool *moved = m_hot.moved;
+	byte *energy = m_hot.energy;
+
 	/* Only process some things every so often */
 	bool recover = FALSE;
 	bool regen = FALSE;
 
+	PROF_BEGIN(PROCESS_MONSTERS);
+
 	/* Time out temporary conditions every ten game turns */
 	if (turn % 10 == 0) {
 		recover = TRUE;
@@ -5085,41 +5263,53 @@ void process_monsters(byte minimum_energy)
 		if (p_ptr->leaving)
 			break;
 
-		/* Access the monster */
-		m_ptr = &m_list[i];
-
 		/* Ignore dead monsters */
-		if (!m_ptr->r_idx)
+		if (!live[i])
 			continue;
 
 		/* Ignore monsters that have already been handled */
-		if (m_ptr->moved)
+		if (moved[i])
 			continue;
 
 		/* Leave monsters without enough energy for later */
-		if (m_ptr->energy < minimum_energy)
+		if (energy[i] < minimum_energy)
 			continue;
 
 		/* Prevent reprocessing */
-		m_ptr->moved = TRUE;
+		moved[i] = TRUE;
 
 		/* Handle temporary monster attributes every ten game turns */
-		if (recover)
-			recover_monster(m_ptr, regen);
+		if (recover) {
+			m_ptr = &m_list[i];
+
+			/* Dormant monsters only regenerate */
+			if (monster_is_dormant(m_ptr)) {
+				if (regen)
+					regen_monster_hp(m_ptr);
+
+				/* Hack -- Update the health bar (always) */
+				if (p_ptr->health_who == i)
+					p_ptr->redraw |= (PR_HEALTH | PR_MON_MANA);
+			} else {
+				recover_monster(m_ptr, regen);
+			}
+		}
 
 		/* Give this monster some energy */
-		m_ptr->energy += extract_energy[m_ptr->mspeed];
+		energy[i] += extract_energy[m_hot.mspeed[i]];
 
 		/* End the turn of monsters without enough energy to move */
-		if (m_ptr->energy < 100)
+		if (energy[i] < 100)
 			continue;
 
 		/* Use up some energy */
-		m_ptr->energy -= 100;
+		energy[i] -= 100;
 
 		/* Let the monster take its turn */
-		process_monster(m_ptr);
+		process_monster(&m_list[i]);
 	}
+
+	PROF_END(PROCESS_MONSTERS);
 }
 
 
@@ -5130,20 +5320,91 @@ void process_monsters(byte minimum_energy)
  */
 void reset_monsters(void)
 {
-	int i;
-	monster_type *m_ptr;
-
-	/* Process the monsters (backwards) */
-	for (i = m_max - 1; i >= 1; i--) {
-		/* Access the monster */
-		m_ptr = &m_list[i];
+	/* Monsters are ready to go again */
+	memset(m_hot.moved, 0, m_max * sizeof(bool));
 
-		/* Monster is ready to go again */
-		m_ptr->moved = FALSE;
-	}
 	/* Clear the current noise after it is used to wake up monsters */
 	if (turn % 10 == 0) {
 		total_wakeup_chance = 0L;
 		add_wakeup_chance = 0;
 	}
 }
+
+
+/**
+ * Check whether every monster on the level is certain to spend its turns
+ * doing nothing until the next time monsters recover.
+ *
+ * Sleeping monsters and those in stasis only change when they recover.  A
+ * passive monster stays passive while the character is out of its range
+ * and it has neither a target nor the scent.  Visible monsters which
+ * shimmer still need their turns to be animated.
+ */
+bool monsters_are_quiet(void)
+{
+	int i;
+
+	for (i = m_max - 1; i >= 1; i--) {
+		monster_type *m_ptr = &m_list[i];
+		monster_race *r_ptr = &r_info[m_ptr->r_idx];
+		int scan_range;
+
+		/* Ignore dead monsters */
+		if (!m_ptr->r_idx)
+			continue;
+
+		/* Shimmering monsters */
+		if ((m_ptr->ml) && (rf_has(r_ptr->flags, RF_ATTR_MULTI) ||
+							rf_has(r_ptr->flags, RF_ATTR_FLICKER)))
+			return (FALSE);
+
+		/* Asleep or held */
+		if ((m_ptr->csleep) || (m_ptr->stasis))
+			continue;
+
+		/* Active monsters, and those yet to take a turn */
+		if ((m_ptr->mflag & (MFLAG_ACTV)) || (m_ptr->min_range == 0))
+			return (FALSE);
+
+		/* Territorial monsters gain energy near home */
+		if ((rf_has(r_ptr->flags, RF_TERRITORIAL))
+			&& (stage_map[p_ptr->stage][STAGE_TYPE] != CAVE))
+			return (FALSE);
+
+		/* Passive monsters which would become active */
+		scan_range = (MODE(SMALL_DEVICE) ? r_ptr->aaf / 2 : r_ptr->aaf);
+		if (m_ptr->cdis <= scan_range)
+			return (FALSE);
+		if ((m_ptr->ty) && (m_ptr->tx))
+			return (FALSE);
+		if ((cave_when[m_ptr->fy][m_ptr->fx]) && (monster_can_smell(m_ptr)))
+			return (FALSE);
+	}
+
+	return (TRUE);
+}
+
+
+/**
+ * Let some game turns pass for monsters which are all quiet; each gains
+ * and uses energy as in process_monsters(), but does nothing else.
+ */
+void pass_quiet_turns(int turns)
+{
+	int i, k;
+
+	for (i = m_max - 1; i >= 1; i--) {
+		/* Ignore dead monsters */
+		if (!m_hot.live[i])
+			continue;
+
+		for (k = 0; k < turns; k++) {
+			/* Give this monster some energy */
+			m_hot.energy[i] += extract_energy[m_hot.mspeed[i]];
+
+			/* Use it up on a turn of doing nothing */
+			if (m_hot.energy[i] >= 100)
+				m_hot.energy[i] -= 100;
+		}
+	}
+}
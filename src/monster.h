@@ -464,9 +464,6 @@ typedef struct monster {
 
     s16b csleep;	/**< Inactive counter */
 
-    byte mspeed;	/**< Monster "speed" */
-    byte energy;	/**< Monster "energy" */
-
     byte stunned;	/**< Monster is stunned */
     byte confused;	/**< Monster is confused */
     byte monfear;	/**< Monster is afraid */
@@ -502,8 +499,6 @@ typedef struct monster {
 
     byte mana;		/**< Current mana level */
 
-    bool moved;		/**< Monster has moved this turn */
-
     byte p_race;	/**< Player-type race for race-based monsters */
     byte old_p_race;	/**< Old player-type race for shapechanged monsters */
     s16b hostile;	/**< Who the monster is hostile to (group id) */
@@ -517,6 +512,28 @@ typedef struct monster {
 } monster_type;
 
 
+/**
+ * Monster scheduling information, for all the monsters in m_list[].
+ *
+ * process_monsters() looks at every monster on the level each game turn,
+ * but most of them only gain energy.  These fields are kept apart from the
+ * monster records, one array each indexed like m_list[], so that sweep can
+ * stay out of the records except for monsters which actually take a turn.
+ */
+typedef struct monster_hot {
+    bool *live;		/**< There is a monster in this slot */
+    bool *moved;	/**< Monster has moved this turn */
+    byte *mspeed;	/**< Monster "speed" */
+    byte *energy;	/**< Monster "energy" */
+} monster_hot;
+
+/*
+ * Speed and energy of the monster at m_ptr, which must point into m_list[]
+ */
+#define mon_speed(M)	(m_hot.mspeed[(M) - m_list])
+#define mon_energy(M)	(m_hot.energy[(M) - m_list])
+
+
 
 
 /* monster1.c */
@@ -527,7 +544,7 @@ extern void describe_monster(int r_idx, bool spoilers);
 extern void roff_top(int r_idx);
 extern void screen_roff(int r_idx);
 extern void display_roff(int r_idx);
-extern bool prepare_ghost(int r_idx, monster_type *m_ptr, bool from_savefile);
+extern bool prepare_ghost(int r_idx, byte *speed, bool from_savefile);
 
 /* monster2.c */
 extern void monster_death(int m_idx);
@@ -536,7 +553,11 @@ extern void delete_monster_idx(int i);
 extern void delete_monster(int y, int x);
 extern void compact_monsters(int size);
 extern void wipe_m_list(void);
+extern void free_mon_vis(void);
 extern s16b m_pop(void);
+extern bool grow_m_list(void);
+extern void resize_monster_hot(monster_hot *h, int old_size, int size);
+extern void clear_monster_hot(monster_hot *h, int size);
 extern errr get_mon_num_prep(void);
 extern s16b get_mon_num(int level);
 extern s16b get_mon_num_quick(int level);
@@ -551,7 +572,8 @@ extern void update_monsters(bool full);
 extern s16b monster_carry(int m_idx, object_type *j_ptr);
 extern void monster_swap(int y1, int x1, int y2, int x2);
 extern s16b player_place(int y, int x);
-extern s16b monster_place(int y, int x, monster_type *n_ptr);
+extern s16b monster_place(int y, int x, monster_type *n_ptr, byte speed,
+			  byte energy);
 extern bool place_monster_aux(int y, int x, int r_idx, bool slp, bool grp);
 extern bool place_monster(int y, int x, bool slp, bool grp, bool quick);
 extern bool alloc_monster(int dis, bool slp, bool quick);
@@ -568,10 +590,14 @@ extern bool make_attack_ranged(monster_type *m_ptr, int attack);
 
 /* monmove.c */
 extern int get_scent(int y, int x);
+extern void init_race_spells(void);
+extern void free_race_spells(void);
 extern int choose_ranged_attack(int m_idx, bool archery_only, int shape_rate);
 extern bool cave_exist_mon(monster_race *r_ptr, int y, int x, 
                            bool occupied_ok);
 extern void process_monsters(byte minimum_energy);
 extern void reset_monsters(void);
+extern bool monsters_are_quiet(void);
+extern void pass_quiet_turns(int turns);
 
 #endif /* !MONSTER_MONSTER_H */
@@ -2218,7 +2218,7 @@ void display_roff(int r_idx)
 /** 
  * Add various player ghost attributes depending on race. -LM-
  */
-static void process_ghost_race(int ghost_race, monster_type * m_ptr)
+static void process_ghost_race(int ghost_race, byte *speed)
 {
 	monster_race *r_ptr = &r_info[PLAYER_GHOST_RACE];
 	byte n;
@@ -2364,7 +2364,7 @@ static void process_ghost_race(int ghost_race, monster_type * m_ptr)
 /** 
  * Add various player ghost attributes depending on class. -LM- 
  */
-static void process_ghost_class(int ghost_class, monster_type * m_ptr)
+static void process_ghost_class(int ghost_class, byte *speed)
 {
 	monster_race *r_ptr = &r_info[PLAYER_GHOST_RACE];
 	int dun_level = r_ptr->level;
@@ -2437,9 +2437,9 @@ static void process_ghost_class(int ghost_class, monster_type * m_ptr)
 			if (dun_level > 19)
 				rsf_on(r_ptr->spell_flags, RSF_HASTE);
 			if (dun_level > 39)
-				m_ptr->mspeed += 5;
-			if (m_ptr->mspeed > 130)
-				m_ptr->mspeed = 130;
+				*speed += 5;
+			if (*speed > 130)
+				*speed = 130;
 
 			rsf_on(r_ptr->spell_flags, RSF_BLINK);
 			rsf_on(r_ptr->spell_flags, RSF_BLIND);
@@ -2505,9 +2505,9 @@ static void process_ghost_class(int ghost_class, monster_type * m_ptr)
 			if (dun_level > 24)
 				rsf_on(r_ptr->spell_flags, RSF_HASTE);
 			if (dun_level > 34)
-				m_ptr->mspeed += 5;
-			if (m_ptr->mspeed > 130)
-				m_ptr->mspeed = 130;
+				*speed += 5;
+			if (*speed > 130)
+				*speed = 130;
 
 			r_ptr->hdice = 4 * r_ptr->hdice / 5;
 
@@ -2821,7 +2821,7 @@ static void process_ghost_class(int ghost_class, monster_type * m_ptr)
  * gender, and add flags depending on the race and class of the slain 
  * adventurer.  -LM-
  */
-bool prepare_ghost(int r_idx, monster_type * m_ptr, bool from_savefile)
+bool prepare_ghost(int r_idx, byte *speed, bool from_savefile)
 {
 	int ghost_sex, ghost_race, ghost_class = 0;
 	byte try, i, backup_file_selector;
@@ -2974,7 +2974,7 @@ bool prepare_ghost(int r_idx, monster_type * m_ptr, bool from_savefile)
 		ghost_race = randint0(z_info->p_max);
 
 	/* And use the ghost race to gain some flags. */
-	process_ghost_race(ghost_race, m_ptr);
+	process_ghost_race(ghost_race, speed);
 
 
   /*** Process class. ***/
@@ -2984,7 +2984,7 @@ bool prepare_ghost(int r_idx, monster_type * m_ptr, bool from_savefile)
 		ghost_class = randint0(CLASS_MAX);
 
 	/* And use the ghost class to gain some flags. */
-	process_ghost_class(ghost_class, m_ptr);
+	process_ghost_class(ghost_class, speed);
 
 	/* Hack - a little extra help for the deepest ghosts */
 	if (p_ptr->depth > 75)
@@ -33,6 +33,106 @@
 #include "types.h"
 
 
+/*
+ * Monster data for the visible monster list
+ */
+typedef struct {
+	u16b count;					/* total number of this type visible */
+	u16b asleep;				/* number asleep (not in LOS) */
+	u16b neutral;				/* number neutral (not in LOS) */
+	u16b los;					/* number in LOS */
+	u16b los_asleep;			/* number asleep and in LOS */
+	u16b los_neutral;			/* number neutral and in LOS */
+	byte attr;					/* attr to use for drawing */
+	s16b r_idx;					/* race of this entry */
+} monster_vis;
+
+/*
+ * The visible monster registry.
+ *
+ * mon_vis_list[] holds the index of every monster with "ml" set, in no
+ * particular order, and mon_vis_pos[] gives each monster's place in it plus
+ * one, or zero if it is not there.  update_mon() keeps it current, so the
+ * monster list only has to look at monsters the player can see.
+ *
+ * mon_vis_types[] and mon_vis_race[] are scratch space for display_monlist().
+ */
+static s16b *mon_vis_list;
+static s16b *mon_vis_pos;
+static int mon_vis_size;
+static int mon_vis_cnt;
+
+static monster_vis *mon_vis_types;
+static u16b *mon_vis_race;
+
+/*
+ * Add a monster to the visible monster registry
+ */
+static void mon_vis_add(int m_idx)
+{
+	/* Keep up with the monster list */
+	if (mon_vis_size < m_size) {
+		mon_vis_list = mem_realloc(mon_vis_list, m_size * sizeof(s16b));
+		mon_vis_pos = mem_realloc(mon_vis_pos, m_size * sizeof(s16b));
+		mon_vis_types = mem_realloc(mon_vis_types,
+									m_size * sizeof(monster_vis));
+		memset(&mon_vis_pos[mon_vis_size], 0,
+			   (m_size - mon_vis_size) * sizeof(s16b));
+		mon_vis_size = m_size;
+	}
+
+	/* Already there */
+	if (mon_vis_pos[m_idx])
+		return;
+
+	mon_vis_list[mon_vis_cnt++] = m_idx;
+	mon_vis_pos[m_idx] = mon_vis_cnt;
+}
+
+/*
+ * Remove a monster from the visible monster registry
+ */
+static void mon_vis_del(int m_idx)
+{
+	int pos;
+
+	/* Not there */
+	if ((m_idx >= mon_vis_size) || !mon_vis_pos[m_idx])
+		return;
+
+	/* Move the last entry into the hole */
+	pos = mon_vis_pos[m_idx] - 1;
+	mon_vis_list[pos] = mon_vis_list[--mon_vis_cnt];
+	mon_vis_pos[mon_vis_list[pos]] = pos + 1;
+	mon_vis_pos[m_idx] = 0;
+}
+
+/*
+ * Free the visible monster registry
+ */
+void free_mon_vis(void)
+{
+	FREE(mon_vis_list);
+	FREE(mon_vis_pos);
+	FREE(mon_vis_types);
+	FREE(mon_vis_race);
+	mon_vis_size = 0;
+	mon_vis_cnt = 0;
+}
+
+
+/**
+ * Clear the scheduling information of an empty monster slot
+ */
+static void wipe_monster_hot_idx(int i)
+{
+	m_hot.live[i] = FALSE;
+	m_hot.moved[i] = FALSE;
+	m_hot.mspeed[i] = 0;
+	m_hot.energy[i] = 0;
+}
+
+
 /**
  * Delete a monster by index.
  *
@@ -74,6 +174,7 @@ void delete_monster_idx(int i)
 
 	/* Monster is gone */
 	cave_m_idx[y][x] = 0;
+	region_remove(&mon_regions, i, y, x);
 
 	/* Total Hack -- If the monster was a player ghost, remove it from the
 	 * monster memory, ensure that it never appears again, clear its bones
@@ -107,8 +208,16 @@ void delete_monster_idx(int i)
 	}
 
 
+	/* No longer visible */
+	mon_vis_del(i);
+
 	/* Wipe the Monster */
 	(void) WIPE(m_ptr, monster_type);
+	wipe_monster_hot_idx(i);
+
+	/* Recycle the slot */
+	m_ptr->hold_o_idx = m_free;
+	m_free = i;
 
 	/* Count monsters */
 	m_cnt--;
@@ -160,6 +269,8 @@ static void compact_monsters_aux(int i1, int i2)
 
 	/* Update the cave */
 	cave_m_idx[y][x] = i2;
+	region_remove(&mon_regions, i1, y, x);
+	region_add(&mon_regions, i2, y, x);
 
 	/* Repair objects being carried by monster */
 	for (this_o_idx = m_ptr->hold_o_idx; this_o_idx;
@@ -184,11 +295,22 @@ static void compact_monsters_aux(int i1, int i2)
 	if (p_ptr->health_who == i1)
 		p_ptr->health_who = i2;
 
+	/* Update the visible monster registry */
+	if (m_ptr->ml) {
+		mon_vis_del(i1);
+		mon_vis_add(i2);
+	}
+
 	/* Hack -- move monster */
 	(void) COPY(&m_list[i2], &m_list[i1], monster_type);
+	m_hot.live[i2] = m_hot.live[i1];
+	m_hot.moved[i2] = m_hot.moved[i1];
+	m_hot.mspeed[i2] = m_hot.mspeed[i1];
+	m_hot.energy[i2] = m_hot.energy[i1];
 
 	/* Hack -- wipe hole */
 	(void) WIPE(&m_list[i1], monster_type);
+	wipe_monster_hot_idx(i1);
 }
 
 
@@ -287,6 +409,9 @@ void compact_monsters(int size)
 		/* Compress "m_max" */
 		m_max--;
 	}
+
+	/* There are no holes left */
+	m_free = 0;
 }
 
 
@@ -331,17 +456,29 @@ void wipe_m_list(void)
 
 		/* Wipe the Monster */
 		(void) WIPE(m_ptr, monster_type);
+		wipe_monster_hot_idx(i);
 	}
 
 	/* Hack - wipe the player */
 	cave_m_idx[p_ptr->py][p_ptr->px] = 0;
 
+	/* Empty the region index */
+	region_clear(&mon_regions, m_size);
+
 	/* Reset "m_max" */
 	m_max = 1;
 
 	/* Reset "m_cnt" */
 	m_cnt = 0;
 
+	/* Reset the free list */
+	m_free = 0;
+
+	/* Nothing is visible */
+	for (i = 0; i < mon_vis_cnt; i++)
+		mon_vis_pos[mon_vis_list[i]] = 0;
+	mon_vis_cnt = 0;
+
 	/* Hack -- reset "reproducer" count */
 	num_repro = 0;
 
@@ -359,6 +496,9 @@ void wipe_m_list(void)
 /**
  * Acquires and returns the index of a "free" monster.
  *
+ * Dead monsters below "m_max" are chained through their "hold_o_idx" field,
+ * starting at "m_free", so this never has to scan the monster list.
+ *
  * This routine should almost never fail, but it *can* happen.
  */
 s16b m_pop(void)
@@ -366,37 +506,35 @@ s16b m_pop(void)
 	int i;
 
 
-	/* Normal allocation */
-	if (m_max < z_info->m_max) {
-		/* Access the next hole */
-		i = m_max;
+	/* Recycle dead monsters */
+	if (m_free) {
+		/* Acquire the first dead monster */
+		i = m_free;
 
-		/* Expand the array */
-		m_max++;
+		/* Unlink it */
+		m_free = m_list[i].hold_o_idx;
+		m_list[i].hold_o_idx = 0;
 
 		/* Count monsters */
 		m_cnt++;
 
-		/* Return the index */
+		/* Use this monster */
 		return (i);
 	}
 
 
-	/* Recycle dead monsters */
-	for (i = 1; i < m_max; i++) {
-		monster_type *m_ptr;
-
-		/* Acquire monster */
-		m_ptr = &m_list[i];
+	/* Normal allocation */
+	if (m_max < m_size) {
+		/* Access the next hole */
+		i = m_max;
 
-		/* Skip live monsters */
-		if (m_ptr->r_idx)
-			continue;
+		/* Expand the array */
+		m_max++;
 
 		/* Count monsters */
 		m_cnt++;
 
-		/* Use this monster */
+		/* Return the index */
 		return (i);
 	}
 
@@ -410,6 +548,83 @@ s16b m_pop(void)
 }
 
 
+/**
+ * Make room for another POOL_CHUNK monsters in the monster list.
+ *
+ * This moves "m_list", so it must only be called when nobody is holding
+ * a pointer into it.  Returns FALSE if the list is already at MAX_M_IDX.
+ */
+bool grow_m_list(void)
+{
+	int size = MIN(m_size + POOL_CHUNK, MAX_M_IDX);
+	int target = 0;
+
+	/* Already full size */
+	if (size <= m_size)
+		return (FALSE);
+
+	/* The target is held by pointer */
+	if (target_get_monster())
+		target = target_get_monster() - m_list;
+
+	/* Grow the list, and clear the new entries */
+	m_list = mem_realloc(m_list, size * sizeof(monster_type));
+	memset(&m_list[m_size], 0, (size - m_size) * sizeof(monster_type));
+	resize_monster_hot(&m_hot, m_size, size);
+	region_resize(&mon_regions, m_size, size);
+	m_size = size;
+
+	/* Hack -- Update the target */
+	if (target)
+		target_set_monster(&m_list[target]);
+
+	return (TRUE);
+}
+
+
+/**
+ * Resize the scheduling information for a monster list of old_size entries
+ * to size entries, clearing any new ones.  A size of zero frees it.
+ */
+void resize_monster_hot(monster_hot *h, int old_size, int size)
+{
+	/* Free everything */
+	if (!size) {
+		mem_free(h->live);
+		mem_free(h->moved);
+		mem_free(h->mspeed);
+		mem_free(h->energy);
+		(void) WIPE(h, monster_hot);
+		return;
+	}
+
+	h->live = mem_realloc(h->live, size * sizeof(bool));
+	h->moved = mem_realloc(h->moved, size * sizeof(bool));
+	h->mspeed = mem_realloc(h->mspeed, size * sizeof(byte));
+	h->energy = mem_realloc(h->energy, size * sizeof(byte));
+
+	/* Clear the new entries */
+	if (size > old_size) {
+		memset(&h->live[old_size], 0, (size - old_size) * sizeof(bool));
+		memset(&h->moved[old_size], 0, (size - old_size) * sizeof(bool));
+		memset(&h->mspeed[old_size], 0, (size - old_size) * sizeof(byte));
+		memset(&h->energy[old_size], 0, (size - old_size) * sizeof(byte));
+	}
+}
+
+
+/**
+ * Clear the scheduling information for a monster list of the given size
+ */
+void clear_monster_hot(monster_hot *h, int size)
+{
+	memset(h->live, 0, size * sizeof(bool));
+	memset(h->moved, 0, size * sizeof(bool));
+	memset(h->mspeed, 0, size * sizeof(byte));
+	memset(h->energy, 0, size * sizeof(byte));
+}
+
+
 /**
  * Apply a "monster restriction function" to the "monster allocation table"
  */
@@ -877,26 +1092,13 @@ static void get_mon_name(char *output_name, size_t max,
 }
 
 
-/*
- * Monster data for the visible monster list
- */
-typedef struct {
-	u16b count;					/* total number of this type visible */
-	u16b asleep;				/* number asleep (not in LOS) */
-	u16b neutral;				/* number neutral (not in LOS) */
-	u16b los;					/* number in LOS */
-	u16b los_asleep;			/* number asleep and in LOS */
-	u16b los_neutral;			/* number neutral and in LOS */
-	byte attr;					/* attr to use for drawing */
-} monster_vis;
-
 /*
  * Display visible monsters in a window
  */
 void display_monlist(void)
 {
 	int ii;
-	size_t i, j, k;
+	size_t i, j;
 	int max;
 	int line = 1, x = 0;
 	int cur_x;
@@ -912,9 +1114,7 @@ void display_monlist(void)
 	monster_race *r_ptr;
 	monster_race *r2_ptr;
 
-	monster_vis *list;
-
-	u16b *order;
+	monster_vis *list = mon_vis_types;
 
 	bool in_term = (Term != angband_term[0]);
 
@@ -938,26 +1138,29 @@ void display_monlist(void)
 		max = Term->hgt - 2;
 	}
 
-	/* Allocate the primary array */
-	list = C_ZNEW(z_info->r_max, monster_vis);
+	/* Map from race to entry, kept clear between calls */
+	if (!mon_vis_race)
+		mon_vis_race = C_ZNEW(z_info->r_max, u16b);
 
-	/* Scan the list of monsters on the level */
-	for (ii = 1; ii < m_max; ii++) {
+	/* Scan the visible monsters */
+	for (ii = 0; ii < mon_vis_cnt; ii++) {
 		monster_vis *v;
 
-		m_ptr = &m_list[ii];
+		m_ptr = &m_list[mon_vis_list[ii]];
 		r_ptr = &r_info[m_ptr->r_idx];
 
-		/* Only consider visible, known monsters */
-		if (!m_ptr->ml)
-			continue;
+		/* Note each monster type */
+		if (!mon_vis_race[m_ptr->r_idx]) {
+			v = &list[type_count++];
+			WIPE(v, monster_vis);
+			v->r_idx = m_ptr->r_idx;
+			mon_vis_race[m_ptr->r_idx] = type_count;
+		}
 
 		/* Take a pointer to this monster visibility entry */
-		v = &list[m_ptr->r_idx];
+		v = &list[mon_vis_race[m_ptr->r_idx] - 1];
 
-		/* Note each monster type and save its display attr (color) */
-		if (!v->count)
-			type_count++;
+		/* Save its display attr (color) */
 		if (!v->attr)
 			v->attr = m_ptr->attr ? m_ptr->attr : r_ptr->x_attr;
 
@@ -993,6 +1196,10 @@ void display_monlist(void)
 		total_count++;
 	}
 
+	/* Clear the race map again */
+	for (i = 0; i < type_count; i++)
+		mon_vis_race[list[i].r_idx] = 0;
+
 	/* Note no visible monsters at all */
 	if (!total_count) {
 		/* Clear display and print note */
@@ -1000,50 +1207,29 @@ void display_monlist(void)
 		if (!in_term)
 			Term_addstr(-1, TERM_WHITE, "  (Press any key to continue.)");
 
-		/* Free up memory */
-		FREE(list);
-
 		/* Done */
 		return;
 	}
 
-	/* Allocate the secondary array */
-	order = C_ZNEW(type_count, u16b);
-
-	/* Sort, because we cannot rely on monster.txt being ordered */
-
-	/* Populate the ordered array, starting at 1 to ignore @ */
-	for (i = 1; i < z_info->r_max; i++) {
-		/* No monsters of this race are visible */
-		if (!list[i].count)
-			continue;
+	/* Sort by depth, because we cannot rely on monster.txt being ordered */
+	for (i = 1; i < type_count; i++) {
+		monster_vis tmp = list[i];
 
 		/* Get the monster info */
-		r_ptr = &r_info[i];
+		r_ptr = &r_info[tmp.r_idx];
 
-		/* Fit this monster into the sorted array */
-		for (j = 0; j < type_count; j++) {
-			/* If we get to the end of the list, put this one in */
-			if (!order[j]) {
-				order[j] = i;
-				break;
-			}
-
-			/* Get the monster info for comparison */
-			r2_ptr = &r_info[order[j]];
-
-			/* Monsters are sorted by depth */
-			if (r_ptr->level > r2_ptr->level) {
-				/* Move weaker monsters down the array */
-				for (k = type_count - 1; k > j; k--) {
-					order[k] = order[k - 1];
-				}
+		/* Deeper monsters first, then in monster.txt order */
+		for (j = i; j > 0; j--) {
+			r2_ptr = &r_info[list[j - 1].r_idx];
 
-				/* Put current monster in the right place */
-				order[j] = i;
+			if ((r2_ptr->level > r_ptr->level)
+				|| ((r2_ptr->level == r_ptr->level)
+					&& (list[j - 1].r_idx < tmp.r_idx)))
 				break;
-			}
+
+			list[j] = list[j - 1];
 		}
+		list[j] = tmp;
 	}
 
 	/* Message for monsters in LOS - even if there are none */
@@ -1057,18 +1243,18 @@ void display_monlist(void)
 	/* Print out in-LOS monsters in descending order */
 	for (i = 0; (i < type_count) && (line < max); i++) {
 		/* Skip if there are none of these in LOS */
-		if (!list[order[i]].los)
+		if (!list[i].los)
 			continue;
 
 		/* Reset position */
 		cur_x = x;
 
 		/* Note that these have been displayed */
-		disp_count += list[order[i]].los;
+		disp_count += list[i].los;
 
 		/* Get monster race and name */
-		r_ptr = &r_info[order[i]];
-		get_mon_name(m_name, sizeof(m_name), r_ptr, list[order[i]].los);
+		r_ptr = &r_info[list[i].r_idx];
+		get_mon_name(m_name, sizeof(m_name), r_ptr, list[i].los);
 
 		/* Display uniques in a special colour */
 		if (rf_has(r_ptr->flags, RF_UNIQUE))
@@ -1079,36 +1265,36 @@ void display_monlist(void)
 			attr = TERM_WHITE;
 
 		/* Build the monster name */
-		if (list[order[i]].los == 1) {
-			if (list[order[i]].los_asleep == 1)
+		if (list[i].los == 1) {
+			if (list[i].los_asleep == 1)
 				strnfmt(buf, sizeof(buf), "%s (asleep) ", m_name);
-			else if (list[order[i]].los_neutral == 1)
+			else if (list[i].los_neutral == 1)
 				strnfmt(buf, sizeof(buf), "%s (neutral) ", m_name);
 			else
 				strnfmt(buf, sizeof(buf), "%s ", m_name);
 
 		} else {
-			if (list[order[i]].los_asleep == 0) {
-				if (list[order[i]].los_neutral == 0)
+			if (list[i].los_asleep == 0) {
+				if (list[i].los_neutral == 0)
 					strnfmt(buf, sizeof(buf), "%s", m_name);
 				else
 					strnfmt(buf, sizeof(buf), "%s (%d neutral) ",
-							m_name, list[order[i]].los_neutral);
+							m_name, list[i].los_neutral);
 			} else {
-				if (list[order[i]].los_neutral == 0)
+				if (list[i].los_neutral == 0)
 					strnfmt(buf, sizeof(buf), "%s (%d asleep) ",
-							m_name, list[order[i]].los_asleep);
+							m_name, list[i].los_asleep);
 				else
 					strnfmt(buf, sizeof(buf),
 							"%s (%d asleep, %d neutral) ", m_name,
-							list[order[i]].los_asleep,
-							list[order[i]].los_neutral);
+							list[i].los_asleep,
+							list[i].los_neutral);
 			}
 		}
 
 		/* Display the pict */
 		if ((tile_width == 1) && (tile_height == 1)) {
-			Term_putch(cur_x++, line, list[order[i]].attr, r_ptr->x_char);
+			Term_putch(cur_x++, line, list[i].attr, r_ptr->x_char);
 			Term_putch(cur_x++, line, TERM_WHITE, L' ');
 		}
 
@@ -1150,10 +1336,10 @@ void display_monlist(void)
 
 	/* Print out non-LOS monsters in descending order */
 	for (i = 0; (i < type_count) && (line < max); i++) {
-		int out_of_los = list[order[i]].count - list[order[i]].los;
+		int out_of_los = list[i].count - list[i].los;
 
 		/* Skip if there are none of these out of LOS */
-		if (list[order[i]].count == list[order[i]].los)
+		if (list[i].count == list[i].los)
 			continue;
 
 		/* Reset position */
@@ -1163,7 +1349,7 @@ void display_monlist(void)
 		disp_count += out_of_los;
 
 		/* Get monster race and name */
-		r_ptr = &r_info[order[i]];
+		r_ptr = &r_info[list[i].r_idx];
 		get_mon_name(m_name, sizeof(m_name), r_ptr, out_of_los);
 
 		/* Display uniques in a special colour */
@@ -1176,34 +1362,34 @@ void display_monlist(void)
 
 		/* Build the monster name */
 		if (out_of_los == 1) {
-			if (list[order[i]].asleep == 1)
+			if (list[i].asleep == 1)
 				strnfmt(buf, sizeof(buf), "%s (asleep) ", m_name);
-			else if (list[order[i]].neutral == 1)
+			else if (list[i].neutral == 1)
 				strnfmt(buf, sizeof(buf), "%s (neutral) ", m_name);
 			else
 				strnfmt(buf, sizeof(buf), "%s ", m_name);
 
 		} else {
-			if (list[order[i]].asleep == 0) {
-				if (list[order[i]].neutral == 0)
+			if (list[i].asleep == 0) {
+				if (list[i].neutral == 0)
 					strnfmt(buf, sizeof(buf), "%s", m_name);
 				else
 					strnfmt(buf, sizeof(buf), "%s (%d neutral) ",
-							m_name, list[order[i]].neutral);
+							m_name, list[i].neutral);
 			} else {
-				if (list[order[i]].neutral == 0)
+				if (list[i].neutral == 0)
 					strnfmt(buf, sizeof(buf), "%s (%d asleep) ",
-							m_name, list[order[i]].asleep);
+							m_name, list[i].asleep);
 				else
 					strnfmt(buf, sizeof(buf),
 							"%s (%d asleep, %d neutral) ", m_name,
-							list[order[i]].asleep, list[order[i]].neutral);
+							list[i].asleep, list[i].neutral);
 			}
 		}
 
 		/* Display the pict */
 		if ((tile_width == 1) && (tile_height == 1)) {
-			Term_putch(cur_x++, line, list[order[i]].attr, r_ptr->x_char);
+			Term_putch(cur_x++, line, list[i].attr, r_ptr->x_char);
 			Term_putch(cur_x++, line, TERM_WHITE, L' ');
 		}
 
@@ -1248,9 +1434,6 @@ void display_monlist(void)
 	if (!in_term)
 		Term_addstr(-1, TERM_WHITE, "  (Press any key to continue.)");
 
-	/* Free the arrays */
-	FREE(list);
-	FREE(order);
 }
 
 
@@ -1827,6 +2010,7 @@ void update_mon(int m_idx, bool full)
 		if (!m_ptr->ml) {
 			/* Mark as visible */
 			m_ptr->ml = TRUE;
+			mon_vis_add(m_idx);
 
 			/* Draw the monster */
 			light_spot(fy, fx);
@@ -1851,6 +2035,7 @@ void update_mon(int m_idx, bool full)
 		if (m_ptr->ml) {
 			/* Mark as not visible */
 			m_ptr->ml = FALSE;
+			mon_vis_del(m_idx);
 
 			/* Erase the monster */
 			light_spot(fy, fx);
@@ -2050,6 +2235,7 @@ void monster_swap(int y1, int x1, int y2, int x2)
 		/* Move monster */
 		m_ptr->fy = y2;
 		m_ptr->fx = x2;
+		region_move(&mon_regions, m1, y1, x1, y2, x2);
 
 		/* Update monster */
 		update_mon(m1, TRUE);
@@ -2073,6 +2259,7 @@ void monster_swap(int y1, int x1, int y2, int x2)
 		/* Move monster */
 		m_ptr->fy = y1;
 		m_ptr->fx = x1;
+		region_move(&mon_regions, m2, y2, x2, y1, x1);
 
 		/* Update monster */
 		update_mon(m2, TRUE);
@@ -2157,8 +2344,11 @@ s16b player_place(int y, int x)
 
 /**
  * Place a copy of a monster in the dungeon XXX XXX
+ *
+ * The speed and energy of the monster are kept in m_hot, not the record.
  */
-s16b monster_place(int y, int x, monster_type * n_ptr)
+s16b monster_place(int y, int x, monster_type * n_ptr, byte speed,
+				   byte energy)
 {
 	s16b m_idx;
 
@@ -2184,10 +2374,14 @@ s16b monster_place(int y, int x, monster_type * n_ptr)
 
 		/* Copy the monster XXX */
 		(void) COPY(m_ptr, n_ptr, monster_type);
+		m_hot.live[m_idx] = TRUE;
+		m_hot.mspeed[m_idx] = speed;
+		m_hot.energy[m_idx] = energy;
 
 		/* Location */
 		m_ptr->fy = y;
 		m_ptr->fx = x;
+		region_add(&mon_regions, m_idx, y, x);
 
 		/* Update the monster */
 		update_mon(m_idx, TRUE);
@@ -2268,6 +2462,7 @@ static bool place_monster_one(int y, int x, int r_idx, bool slp)
 	monster_type *n_ptr;
 	monster_type monster_type_body;
 	feature_type *f_ptr = &f_info[cave_feat[y][x]];
+	byte speed = 0, energy;
 
 	const char *name;
 
@@ -2375,7 +2570,7 @@ static bool place_monster_one(int y, int x, int r_idx, bool slp)
 	 * on it, and forbid ghost creation if something goes wrong.
 	 */
 	if (rf_has(r_ptr->flags, RF_PLAYER_GHOST)) {
-		if (!prepare_ghost(r_idx, n_ptr, FALSE))
+		if (!prepare_ghost(r_idx, &speed, FALSE))
 			return (FALSE);
 
 		name = format("%s, the %s", ghost_name, name);
@@ -2427,24 +2622,24 @@ static bool place_monster_one(int y, int x, int r_idx, bool slp)
 	n_ptr->hp = n_ptr->maxhp;
 
 	/* Extract the monster base speed */
-	n_ptr->mspeed = r_ptr->speed;
+	speed = r_ptr->speed;
 
 	/* Hack -- small racial variety */
 	if (!(rf_has(r_ptr->flags, RF_UNIQUE))) {
 		/* Allow some small variation per monster */
 		i = extract_energy[r_ptr->speed] / 10;
 		if (i)
-			n_ptr->mspeed += rand_spread(0, i);
+			speed += rand_spread(0, i);
 	}
 
 
 	/* Force monster to wait for player */
 	if (rf_has(r_ptr->flags, RF_FORCE_SLEEP)) {
 		/* Give a random starting energy */
-		n_ptr->energy = 0;
+		energy = 0;
 	} else {
 		/* Give a random starting energy */
-		n_ptr->energy = randint0(50);
+		energy = randint0(50);
 	}
 
 	/* Set the group leader, if there is one */
@@ -2516,7 +2711,7 @@ static bool place_monster_one(int y, int x, int r_idx, bool slp)
 	}
 
 	/* Place the monster in the dungeon */
-	if (!monster_place(y, x, n_ptr))
+	if (!monster_place(y, x, n_ptr, speed, energy))
 		return (FALSE);
 
 	/* Deep unique monsters */
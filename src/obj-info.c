@@ -942,7 +942,6 @@ static bool describe_weapon_damage(textblock * tb,
 	int brand[MAX_P_BRAND], slay[MAX_P_SLAY];
 
 	player_state state;
-	object_type inven[INVEN_TOTAL];
 
 	/* Abort if we've nothing to say */
 	if (mode & OINFO_DUMMY)
@@ -999,11 +998,8 @@ static bool describe_weapon_damage(textblock * tb,
 	 * Get the player's hypothetical state, were they to be
 	 * wielding this item (setting irrelevant shield state).
 	 */
-	memcpy(inven, p_ptr->inventory, INVEN_TOTAL * sizeof(object_type));
-	inven[INVEN_WIELD] = *o_ptr;
 	state.shield_on_back = FALSE;
-
-	calc_bonuses(inven, &state, TRUE);
+	calc_bonuses_what_if(o_ptr, INVEN_WIELD, &state);
 
 	show_m_tohit = state.dis_to_h;
 	if (if_has(o_ptr->id_other, IF_TO_H) || full)
@@ -1299,8 +1295,6 @@ static bool describe_digger(textblock * tb, const object_type * o_ptr,
 {
 	player_state st;
 
-	object_type inven[INVEN_TOTAL];
-
 	int sl = wield_slot(o_ptr);
 	int i;
 
@@ -1316,7 +1310,7 @@ static bool describe_digger(textblock * tb, const object_type * o_ptr,
 				   (o_ptr->bonus_other[P_BONUS_TUNNEL] == 0)))
 		return FALSE;
 
-	memcpy(inven, p_ptr->inventory, INVEN_TOTAL * sizeof(object_type));
+	st.shield_on_back = FALSE;
 
 	/*
 	 * Hack -- if we examine a ring that is worn on the right finger,
@@ -1324,10 +1318,9 @@ static bool describe_digger(textblock * tb, const object_type * o_ptr,
 	 * digging skills.
 	 */
 	if (o_ptr != &p_ptr->inventory[INVEN_RIGHT])
-		inven[sl] = *o_ptr;
-
-	st.shield_on_back = FALSE;
-	calc_bonuses(inven, &st, TRUE);
+		calc_bonuses_what_if(o_ptr, sl, &st);
+	else
+		calc_bonuses(p_ptr->inventory, &st, TRUE);
 
 	chances[0] = st.skills[SKILL_DIGGING] * 8;
 	chances[1] = (st.skills[SKILL_DIGGING] - 10) * 4;
@@ -894,6 +894,9 @@ void excise_object_idx(int o_idx)
 		int y = j_ptr->iy;
 		int x = j_ptr->ix;
 
+		/* Leave the region index */
+		region_remove(&obj_regions, o_idx, y, x);
+
 		/* Scan all objects in the grid */
 		for (this_o_idx = cave_o_idx[y][x]; this_o_idx;
 			 this_o_idx = next_o_idx) {
@@ -938,6 +941,73 @@ void excise_object_idx(int o_idx)
 }
 
 
+/*
+ * The seen object registry.
+ *
+ * obj_seen_list[] holds the index of every floor object that has been
+ * marked, in no particular order, and obj_seen_pos[] gives each object's
+ * place in it plus one, or zero if it is not there.  Objects are added
+ * when they are marked and removed when they are deleted; anything that
+ * has since been forgotten or picked up by a monster is dropped the next
+ * time display_itemlist() walks the list.
+ */
+static s16b *obj_seen_list;
+static s16b *obj_seen_pos;
+static int obj_seen_size;
+static int obj_seen_cnt;
+
+/*
+ * Add a marked floor object to the seen object registry
+ */
+void obj_seen_add(int o_idx)
+{
+	/* Keep up with the object list */
+	if (obj_seen_size < o_size) {
+		obj_seen_list = mem_realloc(obj_seen_list, o_size * sizeof(s16b));
+		obj_seen_pos = mem_realloc(obj_seen_pos, o_size * sizeof(s16b));
+		memset(&obj_seen_pos[obj_seen_size], 0,
+			   (o_size - obj_seen_size) * sizeof(s16b));
+		obj_seen_size = o_size;
+	}
+
+	/* Already there */
+	if (obj_seen_pos[o_idx])
+		return;
+
+	obj_seen_list[obj_seen_cnt++] = o_idx;
+	obj_seen_pos[o_idx] = obj_seen_cnt;
+}
+
+/*
+ * Remove an object from the seen object registry
+ */
+static void obj_seen_del(int o_idx)
+{
+	int pos;
+
+	/* Not there */
+	if ((o_idx >= obj_seen_size) || !obj_seen_pos[o_idx])
+		return;
+
+	/* Move the last entry into the hole */
+	pos = obj_seen_pos[o_idx] - 1;
+	obj_seen_list[pos] = obj_seen_list[--obj_seen_cnt];
+	obj_seen_pos[obj_seen_list[pos]] = pos + 1;
+	obj_seen_pos[o_idx] = 0;
+}
+
+/*
+ * Free the seen object registry
+ */
+void free_obj_seen(void)
+{
+	FREE(obj_seen_list);
+	FREE(obj_seen_pos);
+	obj_seen_size = 0;
+	obj_seen_cnt = 0;
+}
+
+
 /*
  * Delete a dungeon object
  *
@@ -965,9 +1035,16 @@ void delete_object_idx(int o_idx)
 		light_spot(y, x);
 	}
 
+	/* Forget it */
+	obj_seen_del(o_idx);
+
 	/* Wipe the object */
 	object_wipe(j_ptr);
 
+	/* Recycle the slot */
+	j_ptr->next_o_idx = o_free;
+	o_free = o_idx;
+
 	/* Count objects */
 	o_cnt--;
 }
@@ -997,9 +1074,17 @@ void delete_object(int y, int x)
 		/* Get the next object */
 		next_o_idx = o_ptr->next_o_idx;
 
+		/* Forget it */
+		obj_seen_del(this_o_idx);
+		region_remove(&obj_regions, this_o_idx, y, x);
+
 		/* Wipe the object */
 		object_wipe(o_ptr);
 
+		/* Recycle the slot */
+		o_ptr->next_o_idx = o_free;
+		o_free = this_o_idx;
+
 		/* Count objects */
 		o_cnt--;
 	}
@@ -1071,9 +1156,19 @@ static void compact_objects_aux(int i1, int i2)
 			/* Repair */
 			cave_o_idx[y][x] = i2;
 		}
+
+		/* Repair the region index */
+		region_remove(&obj_regions, i1, y, x);
+		region_add(&obj_regions, i2, y, x);
 	}
 
 
+	/* Update the seen object registry */
+	if (i1 < obj_seen_size && obj_seen_pos[i1]) {
+		obj_seen_del(i1);
+		obj_seen_add(i2);
+	}
+
 	/* Hack -- move object */
 	COPY(&o_list[i2], &o_list[i1], object_type);
 
@@ -1123,6 +1218,9 @@ void compact_objects(int size)
 			/* Compress "o_max" */
 			o_max--;
 		}
+
+		/* There are no holes left */
+		o_free = 0;
 		return;
 	}
 
@@ -1270,17 +1368,31 @@ void wipe_o_list(void)
 		(void) WIPE(o_ptr, object_type);
 	}
 
+	/* Empty the region index */
+	region_clear(&obj_regions, o_size);
+
 	/* Reset "o_max" */
 	o_max = 1;
 
 	/* Reset "o_cnt" */
 	o_cnt = 0;
+
+	/* Reset the free list */
+	o_free = 0;
+
+	/* Nothing is seen */
+	for (i = 0; i < obj_seen_cnt; i++)
+		obj_seen_pos[obj_seen_list[i]] = 0;
+	obj_seen_cnt = 0;
 }
 
 
 /*
  * Get and return the index of a "free" object.
  *
+ * Dead objects below "o_max" are chained through their "next_o_idx" field,
+ * starting at "o_free", so this never has to scan the object list.
+ *
  * This routine should almost never fail, but in case it does,
  * we must be sure to handle "failure" of this routine.
  */
@@ -1289,13 +1401,14 @@ s16b o_pop(void)
 	int i;
 
 
-	/* Initial allocation */
-	if (o_max < z_info->o_max) {
-		/* Get next space */
-		i = o_max;
+	/* Recycle dead objects */
+	if (o_free) {
+		/* Get the first dead object */
+		i = o_free;
 
-		/* Expand object array */
-		o_max++;
+		/* Unlink it */
+		o_free = o_list[i].next_o_idx;
+		o_list[i].next_o_idx = 0;
 
 		/* Count objects */
 		o_cnt++;
@@ -1305,16 +1418,13 @@ s16b o_pop(void)
 	}
 
 
-	/* Recycle dead objects */
-	for (i = 1; i < o_max; i++) {
-		object_type *o_ptr;
-
-		/* Get the object */
-		o_ptr = &o_list[i];
+	/* Initial allocation */
+	if (o_max < o_size) {
+		/* Get next space */
+		i = o_max;
 
-		/* Skip live objects */
-		if (o_ptr->k_idx)
-			continue;
+		/* Expand object array */
+		o_max++;
 
 		/* Count objects */
 		o_cnt++;
@@ -1333,6 +1443,30 @@ s16b o_pop(void)
 }
 
 
+/*
+ * Make room for another POOL_CHUNK objects in the object list.
+ *
+ * This moves "o_list", so it must only be called when nobody is holding
+ * a pointer into it.  Returns FALSE if the list is already at MAX_O_IDX.
+ */
+bool grow_o_list(void)
+{
+	int size = MIN(o_size + POOL_CHUNK, MAX_O_IDX);
+
+	/* Already full size */
+	if (size <= o_size)
+		return (FALSE);
+
+	/* Grow the list, and clear the new entries */
+	o_list = mem_realloc(o_list, size * sizeof(object_type));
+	memset(&o_list[o_size], 0, (size - o_size) * sizeof(object_type));
+	region_resize(&obj_regions, o_size, size);
+	o_size = size;
+
+	return (TRUE);
+}
+
+
 /*
  * Get the first object at a dungeon location
  * or NULL if there isn't one.
@@ -2481,6 +2615,11 @@ s16b floor_carry(int y, int x, object_type * j_ptr)
 
 		/* Link the floor to the object */
 		cave_o_idx[y][x] = o_idx;
+		region_add(&obj_regions, o_idx, y, x);
+
+		/* Already known */
+		if (o_ptr->marked)
+			obj_seen_add(o_idx);
 
 		/* Notice */
 		note_spot(y, x);
@@ -4269,16 +4408,30 @@ void display_object_kind_recall(s16b k_idx)
 	display_object_recall(&object);
 }
 
+/*
+ * Compare two grids, for sorting them into the order of a scan of the map
+ */
+static int cmp_grid(const void *a, const void *b)
+{
+	return *(const int *) a - *(const int *) b;
+}
+
 /*
  * Display visible items, similar to display_monlist
+ *
+ * The piles are visited in map order, top to bottom and left to right, as
+ * a scan of every grid would; the seen object registry only says which
+ * grids to look at.
  */
 void display_itemlist(void)
 {
 	int max;
 	int mx, my;
-	unsigned num;
 	int line = 1, x = 0;
 	int cur_x;
+	int n, g, num, pile;
+	int *grids;
+	int floor_list[MAX_FLOOR_STACK];
 	unsigned i;
 	unsigned disp_count = 0;
 	byte a;
@@ -4289,18 +4442,9 @@ void display_itemlist(void)
 	int dx[MAX_ITEMLIST], dy[MAX_ITEMLIST];
 	unsigned counter = 0;
 
-	int dungeon_hgt = DUNGEON_HGT;
-	int dungeon_wid = DUNGEON_WID;
-
 	byte attr;
 	char buf[80];
 
-	int floor_list[MAX_FLOOR_STACK];
-
-	/* Adjust for town */
-	if (p_ptr->depth == 0)
-		town_adjust(&dungeon_hgt, &dungeon_wid);
-
 	/* Clear the term if in a subwindow, set x otherwise */
 	if (Term != angband_term[0]) {
 		clear_from(0);
@@ -4310,74 +4454,99 @@ void display_itemlist(void)
 		max = Term->hgt - 2;
 	}
 
-	/* Look at each square of the dungeon for items */
-	for (my = 0; my < dungeon_hgt; my++) {
-		for (mx = 0; mx < dungeon_wid; mx++) {
-			num = scan_floor(floor_list, MAX_FLOOR_STACK, my, mx, 0x02);
+	/* Find the grids of the seen objects (backwards, as we may drop entries) */
+	grids = C_ZNEW(MAX(obj_seen_cnt, 1), int);
+	for (num = 0, n = obj_seen_cnt - 1; n >= 0; n--) {
+		int o_idx = obj_seen_list[n];
+		object_type *o_ptr = &o_list[o_idx];
 
-			/* Iterate over all the items found on this square */
-			for (i = 0; i < num; i++) {
-				object_type *o_ptr = &o_list[floor_list[i]];
-				unsigned j;
+		/* Drop objects that are gone, forgotten or carried off */
+		if (!o_ptr->k_idx || !o_ptr->marked || o_ptr->held_m_idx) {
+			obj_seen_del(o_idx);
+			continue;
+		}
 
-				/* Skip gold/squelched */
-				if (o_ptr->tval == TV_GOLD || squelch_hide_item(o_ptr))
-					continue;
+		grids[num++] = GRID(o_ptr->iy, o_ptr->ix);
+	}
 
-				/* See if we've already seen a similar item; if so, just add */
-				/* to its count */
-				for (j = 0; j < counter; j++) {
-					if (object_similar(o_ptr, types[j], OSTACK_LIST)) {
-						counts[j] += o_ptr->number;
-						if ((my - p_ptr->py) * (my - p_ptr->py) +
-							(mx - p_ptr->px) * (mx - p_ptr->px) <
-							dy[j] * dy[j] + dx[j] * dx[j]) {
-							dy[j] = my - p_ptr->py;
-							dx[j] = mx - p_ptr->px;
-						}
-						break;
+	/* Put the grids in map order */
+	sort(grids, num, sizeof(int), cmp_grid);
+
+	/* Look at each pile, skipping grids already seen */
+	for (g = 0; g < num; g++) {
+		if (g && (grids[g] == grids[g - 1]))
+			continue;
+
+		/* Location */
+		my = GRID_Y(grids[g]);
+		mx = GRID_X(grids[g]);
+
+		pile = scan_floor(floor_list, MAX_FLOOR_STACK, my, mx, 0x02);
+
+		/* Iterate over all the items found on this square */
+		for (n = 0; n < pile; n++) {
+			object_type *o_ptr = &o_list[floor_list[n]];
+			unsigned j;
+
+			/* Skip gold/squelched */
+			if (o_ptr->tval == TV_GOLD || squelch_hide_item(o_ptr))
+				continue;
+
+			/* See if we've already seen a similar item; if so, just add */
+			/* to its count */
+			for (j = 0; j < counter; j++) {
+				if (object_similar(o_ptr, types[j], OSTACK_LIST)) {
+					counts[j] += o_ptr->number;
+					if ((my - p_ptr->py) * (my - p_ptr->py) +
+						(mx - p_ptr->px) * (mx - p_ptr->px) <
+						dy[j] * dy[j] + dx[j] * dx[j]) {
+						dy[j] = my - p_ptr->py;
+						dx[j] = mx - p_ptr->px;
 					}
+					break;
 				}
+			}
 
-				/* We saw a new item. So insert it at the end of the list and */
-				/* then sort it forward using compare_items(). The types list */
-				/* is always kept sorted. */
-				/* If we have too many items, replace the last (normally least important) */
-				/* item in the list. */
-				if (j == counter) {
-					if (counter == MAX_ITEMLIST) {
-						counter -= 1;
-						j -= 1;
-					}
-					types[counter] = o_ptr;
-					counts[counter] = o_ptr->number;
-					dy[counter] = my - p_ptr->py;
-					dx[counter] = mx - p_ptr->px;
-
-					while (j > 0
-						   && compare_items(types[j - 1], types[j]) > 0) {
-						object_type *tmp_o = types[j - 1];
-						int tmpcount;
-						int tmpdx = dx[j - 1];
-						int tmpdy = dy[j - 1];
-
-						types[j - 1] = types[j];
-						types[j] = tmp_o;
-						dx[j - 1] = dx[j];
-						dx[j] = tmpdx;
-						dy[j - 1] = dy[j];
-						dy[j] = tmpdy;
-						tmpcount = counts[j - 1];
-						counts[j - 1] = counts[j];
-						counts[j] = tmpcount;
-						j--;
-					}
-					counter++;
+			/* We saw a new item. So insert it at the end of the list and */
+			/* then sort it forward using compare_items(). The types list */
+			/* is always kept sorted. */
+			/* If we have too many items, replace the last (normally least important) */
+			/* item in the list. */
+			if (j == counter) {
+				if (counter == MAX_ITEMLIST) {
+					counter -= 1;
+					j -= 1;
+				}
+				types[counter] = o_ptr;
+				counts[counter] = o_ptr->number;
+				dy[counter] = my - p_ptr->py;
+				dx[counter] = mx - p_ptr->px;
+
+				while (j > 0
+					   && compare_items(types[j - 1], types[j]) > 0) {
+					object_type *tmp_o = types[j - 1];
+					int tmpcount;
+					int tmpdx = dx[j - 1];
+					int tmpdy = dy[j - 1];
+
+					types[j - 1] = types[j];
+					types[j] = tmp_o;
+					dx[j - 1] = dx[j];
+					dx[j] = tmpdx;
+					dy[j - 1] = dy[j];
+					dy[j] = tmpdy;
+					tmpcount = counts[j - 1];
+					counts[j - 1] = counts[j];
+					counts[j] = tmpcount;
+					j--;
 				}
+				counter++;
 			}
 		}
 	}
 
+	FREE(grids);
+
 	/* Note no visible items */
 	if (!counter) {
 		/* Clear display and print note */
@@ -810,6 +810,9 @@ void delete_object(int y, int x);
 void compact_objects(int size);
 void wipe_o_list(void);
 s16b o_pop(void);
+bool grow_o_list(void);
+void obj_seen_add(int o_idx);
+void free_obj_seen(void);
 object_type *get_first_object(int y, int x);
 object_type *get_next_object(const object_type *o_ptr);
 s32b object_value(const object_type *o_ptr);
@@ -891,6 +894,7 @@ bool check_set(byte s_idx);
 void apply_set(int s_idx);
 void remove_set(int s_idx);
 bool pack_is_full(void);
+bool pack_is_overfull(void);
 void pack_overflow(void);
 
 /* obj-ui.c */
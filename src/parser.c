@@ -22,6 +22,10 @@
  * Each hook has a list of specs, which are essentially named formal parameters;
  * when we run a particular hook across a line, each spec in the hook is
  * assigned a value.
+ *
+ * Hooks are found through a small hash table keyed on the directive, and each
+ * line is copied once into a reusable buffer and tokenised in place, so that
+ * parsing a line normally does no allocation at all.
  */
 
 
@@ -84,8 +88,13 @@ struct parser_spec {
 	const char *name;
 };
 
+/*
+ * Values live in a per-parser arena which is reused for every line; string
+ * values point straight into the parser's line buffer, so they are only
+ * valid until the next call to parser_parse().
+ */
 struct parser_value {
-	struct parser_spec spec;
+	const struct parser_spec *spec;
 	union {
 		wchar_t cval;
 		int ival;
@@ -99,6 +108,8 @@ struct parser_hook {
 	struct parser_hook *next;
 	enum parser_error (*func)(struct parser *p);
 	char *dir;
+	u32b hash;
+	size_t nspecs;
 	struct parser_spec *fhead;
 	struct parser_spec *ftail;
 };
@@ -109,8 +120,21 @@ struct parser {
 	unsigned int colno;
 	char errmsg[1024];
 	struct parser_hook *hooks;
-	struct parser_value *fhead;
-	struct parser_value *ftail;
+
+	/* Directive lookup table, open addressed, size a power of two */
+	struct parser_hook **table;
+	size_t table_size;
+	size_t table_used;
+
+	/* Reusable line buffer, tokenised in place */
+	char *line;
+	size_t line_size;
+
+	/* Value arena for the current line */
+	struct parser_value *values;
+	size_t nvalues;
+	size_t max_values;
+
 	void *priv;
 };
 
@@ -119,28 +143,70 @@ struct parser *parser_new(void) {
 	return p;
 }
 
+/**
+ * Hash a directive name; directives are short, so a simple FNV-1a will do.
+ */
+static u32b hash_directive(const char *dir) {
+	u32b h = 2166136261UL;
+	while (*dir) {
+		h ^= (byte)*dir++;
+		h *= 16777619UL;
+	}
+	return h;
+}
+
+static struct parser_hook *findhook_hashed(struct parser *p, const char *dir,
+		u32b hash) {
+	size_t i;
+
+	if (!p->table_size)
+		return NULL;
+
+	i = hash & (p->table_size - 1);
+	while (p->table[i]) {
+		if (p->table[i]->hash == hash && streq(p->table[i]->dir, dir))
+			return p->table[i];
+		i = (i + 1) & (p->table_size - 1);
+	}
+	return NULL;
+}
+
 static struct parser_hook *findhook(struct parser *p, const char *dir) {
-	struct parser_hook *h = p->hooks;
-	while (h)
-	{
-		if (!strcmp(h->dir, dir))
+	return findhook_hashed(p, dir, hash_directive(dir));
+}
+
+/**
+ * Put a hook into the directive table, superseding any older hook with the
+ * same directive.  The table is kept at most half full.
+ */
+static void table_insert(struct parser_hook **table, size_t size,
+		struct parser_hook *h) {
+	size_t i = h->hash & (size - 1);
+	while (table[i]) {
+		if (table[i]->hash == h->hash && streq(table[i]->dir, h->dir))
 			break;
-		h = h->next;
+		i = (i + 1) & (size - 1);
 	}
-	return h;
+	table[i] = h;
 }
 
-static void parser_freeold(struct parser *p) {
-	struct parser_value *v;
-	while (p->fhead)
-	{
-		int t = p->fhead->spec.type & ~PARSE_T_OPT;
-		v = (struct parser_value *)p->fhead->spec.next;
-		if (t == PARSE_T_SYM || t == PARSE_T_STR)
-			mem_free(p->fhead->u.sval);
-		mem_free(p->fhead);
-		p->fhead = v;
+static void table_add(struct parser *p, struct parser_hook *h) {
+	if ((p->table_used + 1) * 2 > p->table_size) {
+		size_t i, old_size = p->table_size;
+		struct parser_hook **old = p->table;
+
+		p->table_size = old_size ? old_size * 2 : 16;
+		p->table = mem_zalloc(p->table_size * sizeof *p->table);
+		for (i = 0; i < old_size; i++)
+			if (old[i])
+				table_insert(p->table, p->table_size, old[i]);
+		mem_free(old);
 	}
+
+	/* Only a new directive takes up another slot */
+	if (!findhook_hashed(p, h->dir, h->hash))
+		p->table_used++;
+	table_insert(p->table, p->table_size, h);
 }
 
 static bool parse_random(const char *str, random_value *bonus) {
@@ -243,24 +309,57 @@ static bool parse_random(const char *str, random_value *bonus) {
 	return TRUE;
 }
 
+/**
+ * Pull the next token out of the line buffer, in place.
+ *
+ * This mirrors what the old strtok()-based code did: delimited tokens skip
+ * any leading ':' and are terminated at the next one, while undelimited
+ * tokens take the rest of the line.  `pos` is left just past the token.
+ */
+static char *next_token(char **pos, bool delimited) {
+	char *s = *pos;
+	char *e;
+
+	if (delimited)
+		while (*s == ':')
+			s++;
+
+	if (!*s) {
+		*pos = s;
+		return NULL;
+	}
+
+	if (!delimited) {
+		*pos = s + strlen(s);
+		return s;
+	}
+
+	e = strchr(s, ':');
+	if (e) {
+		*e = '\0';
+		*pos = e + 1;
+	} else {
+		*pos = s + strlen(s);
+	}
+
+	return s;
+}
+
 /* This is a bit long and should probably be refactored a bit. */
 enum parser_error parser_parse(struct parser *p, const char *line) {
-	char *cline;
 	char *tok;
+	char *sp;
+	size_t len;
 	struct parser_hook *h;
 	struct parser_spec *s;
 	struct parser_value *v;
-	char *sp = NULL;
 
 	assert(p);
 	assert(line);
 
-	parser_freeold(p);
-
 	p->lineno++;
 	p->colno = 1;
-	p->fhead = NULL;
-	p->ftail = NULL;
+	p->nvalues = 0;
 
 	/* Ignore empty lines and comments. */
 	while (*line && (isspace(*line)))
@@ -268,11 +367,17 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 	if (!*line || *line == '#')
 		return PARSE_ERROR_NONE;
 
-	cline = string_make(line);
+	/* Copy into the line buffer, which only ever grows */
+	len = strlen(line) + 1;
+	if (len > p->line_size) {
+		p->line_size = MAX(len, 1024);
+		p->line = mem_realloc(p->line, p->line_size);
+	}
+	memcpy(p->line, line, len);
+	sp = p->line;
 
-	tok = strtok(cline, ":");
+	tok = next_token(&sp, TRUE);
 	if (!tok) {
-		mem_free(cline);
 		p->error = PARSE_ERROR_MISSING_FIELD;
 		return PARSE_ERROR_MISSING_FIELD;
 	}
@@ -281,7 +386,6 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 	if (!h) {
 		my_strcpy(p->errmsg, tok, sizeof(p->errmsg));
 		p->error = PARSE_ERROR_UNDEFINED_DIRECTIVE;
-		mem_free(cline);
 		return PARSE_ERROR_UNDEFINED_DIRECTIVE;
 	}
 
@@ -294,43 +398,37 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 		int t = s->type & ~PARSE_T_OPT;
 		p->colno++;
 		/* These types are tokenized on ':'; strings are not tokenized
-		 * at all (i.e., they consume the remainder of the line) */
+		 * at all (i.e., they consume the remainder of the line), and a
+		 * char is one character plus its trailing ':' */
 		if (t == PARSE_T_INT || t == PARSE_T_SYM || t == PARSE_T_RAND || t == PARSE_T_UINT) {
-			tok = strtok(sp, ":");
-			sp = NULL;
+			tok = next_token(&sp, TRUE);
 		} else if (t == PARSE_T_CHAR) {
-			tok = strtok(sp, "");
+			tok = next_token(&sp, FALSE);
 			if (tok)
-				sp = tok + 2;
+				sp = tok[1] ? tok + 2 : tok + 1;
 		} else {
-			tok = strtok(sp, "");
-			sp = NULL;
+			tok = next_token(&sp, FALSE);
 		}
 		if (!tok)
 		{
 			if (!(s->type & PARSE_T_OPT)) {
 				my_strcpy(p->errmsg, s->name, sizeof(p->errmsg));
 				p->error = PARSE_ERROR_MISSING_FIELD;
-				mem_free(cline);
 				return PARSE_ERROR_MISSING_FIELD;
 			}
 			break;
 		}
 
-		/* Allocate a value node, parse out its value, and link it into
-		 * the value list. */
-		v = mem_alloc(sizeof *v);
-		v->spec.next = NULL;
-		v->spec.type = s->type;
-		v->spec.name = s->name;
+		/* Take the next value slot and parse its value out. */
+		assert(p->nvalues < p->max_values);
+		v = &p->values[p->nvalues];
+		v->spec = s;
 		if (t == PARSE_T_INT)
 		{
 			char *z = NULL;
 			v->u.ival = strtol(tok, &z, 0);
 			if (z == tok)
 			{
-				mem_free(v);
-				mem_free(cline);
 				my_strcpy(p->errmsg, s->name, sizeof(p->errmsg));
 				p->error = PARSE_ERROR_NOT_NUMBER;
 				return PARSE_ERROR_NOT_NUMBER;
@@ -342,8 +440,6 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 			v->u.uval = strtoul(tok, &z, 0);
 			if (z == tok || *tok == '-')
 			{
-				mem_free(v);
-				mem_free(cline);
 				my_strcpy(p->errmsg, s->name, sizeof(p->errmsg));
 				p->error = PARSE_ERROR_NOT_NUMBER;
 				return PARSE_ERROR_NOT_NUMBER;
@@ -355,28 +451,20 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 		}
 		else if (t == PARSE_T_SYM || t == PARSE_T_STR)
 		{
-			v->u.sval = string_make(tok);
+			v->u.sval = tok;
 		}
 		else if (t == PARSE_T_RAND)
 		{
 			if (!parse_random(tok, &v->u.rval))
 			{
-				mem_free(v);
-				mem_free(cline);
 				my_strcpy(p->errmsg, s->name, sizeof(p->errmsg));
 				p->error = PARSE_ERROR_NOT_RANDOM;
 				return PARSE_ERROR_NOT_RANDOM;
 			}
 		}
-		if (!p->fhead)
-			p->fhead = v;
-		else
-			p->ftail->spec.next = &v->spec;
-		p->ftail = v;
+		p->nvalues++;
 	}
 
-	mem_free(cline);
-
 	p->error = h->func(p);
 	return p->error;
 }
@@ -425,7 +513,6 @@ static void clean_specs(struct parser_hook *h) {
 
 void parser_destroy(struct parser *p) {
 	struct parser_hook *h;
-	parser_freeold(p);
 	while (p->hooks)
 	{
 		h = p->hooks->next;
@@ -433,6 +520,9 @@ void parser_destroy(struct parser *p) {
 		mem_free(p->hooks);
 		p->hooks = h;
 	}
+	mem_free(p->table);
+	mem_free(p->line);
+	mem_free(p->values);
 	mem_free(p);
 }
 
@@ -449,6 +539,8 @@ static errr parse_specs(struct parser_hook *h, char *fmt) {
 	if (!name)
 		return -EINVAL;
 	h->dir = string_make(name);
+	h->hash = hash_directive(h->dir);
+	h->nspecs = 0;
 	h->fhead = NULL;
 	h->ftail = NULL;
 	while (name)
@@ -496,6 +588,7 @@ static errr parse_specs(struct parser_hook *h, char *fmt) {
 		else
 			h->fhead = s;
 		h->ftail = s;
+		h->nspecs++;
 	}
 
 	return 0;
@@ -524,7 +617,16 @@ errr parser_reg(struct parser *p, const char *fmt,
 	}
 
 	p->hooks = h;
+	table_add(p, h);
 	mem_free(cfmt);
+
+	/* Make sure the value arena can hold a full line for this hook */
+	if (h->nspecs > p->max_values) {
+		p->max_values = h->nspecs;
+		p->values = mem_realloc(p->values,
+				p->max_values * sizeof *p->values);
+	}
+
 	return 0;
 }
 
@@ -533,22 +635,22 @@ enum parser_error ignored(struct parser *p) {
 }
 
 bool parser_hasval(struct parser *p, const char *name) {
-	struct parser_value *v;
-	for (v = p->fhead; v; v = (struct parser_value *)v->spec.next)
+	size_t i;
+	for (i = 0; i < p->nvalues; i++)
 	{
-		if (!strcmp(v->spec.name, name))
+		if (!strcmp(p->values[i].spec->name, name))
 			return TRUE;
 	}
 	return FALSE;
 }
 
 static struct parser_value *parser_getval(struct parser *p, const char *name) {
-	struct parser_value *v;
-	for (v = p->fhead; v; v = (struct parser_value *)v->spec.next)
+	size_t i;
+	for (i = 0; i < p->nvalues; i++)
 	{
-		if (!strcmp(v->spec.name, name))
+		if (!strcmp(p->values[i].spec->name, name))
 		{
-			return v;
+			return &p->values[i];
 		}
 	}
 	quit_fmt("parser_getval error: name is %s\n", name);
@@ -557,37 +659,37 @@ static struct parser_value *parser_getval(struct parser *p, const char *name) {
 
 const char *parser_getsym(struct parser *p, const char *name) {
 	struct parser_value *v = parser_getval(p, name);
-	assert((v->spec.type & ~PARSE_T_OPT) == PARSE_T_SYM);
+	assert((v->spec->type & ~PARSE_T_OPT) == PARSE_T_SYM);
 	return v->u.sval;
 }
 
 int parser_getint(struct parser *p, const char *name) {
 	struct parser_value *v = parser_getval(p, name);
-	assert((v->spec.type & ~PARSE_T_OPT) == PARSE_T_INT);
+	assert((v->spec->type & ~PARSE_T_OPT) == PARSE_T_INT);
 	return v->u.ival;
 }
 
 unsigned int parser_getuint(struct parser *p, const char *name) {
 	struct parser_value *v = parser_getval(p, name);
-	assert((v->spec.type & ~PARSE_T_OPT) == PARSE_T_UINT);
+	assert((v->spec->type & ~PARSE_T_OPT) == PARSE_T_UINT);
 	return v->u.uval;
 }
 
 const char *parser_getstr(struct parser *p, const char *name) {
 	struct parser_value *v = parser_getval(p, name);
-	assert((v->spec.type & ~PARSE_T_OPT) == PARSE_T_STR);
+	assert((v->spec->type & ~PARSE_T_OPT) == PARSE_T_STR);
 	return v->u.sval;
 }
 
 struct random parser_getrand(struct parser *p, const char *name) {
 	struct parser_value *v = parser_getval(p, name);
-	assert((v->spec.type & ~PARSE_T_OPT) == PARSE_T_RAND);
+	assert((v->spec->type & ~PARSE_T_OPT) == PARSE_T_RAND);
 	return v->u.rval;
 }
 
 wchar_t parser_getchar(struct parser *p, const char *name) {
 	struct parser_value *v = parser_getval(p, name);
-	assert((v->spec.type & ~PARSE_T_OPT) == PARSE_T_CHAR);
+	assert((v->spec->type & ~PARSE_T_OPT) == PARSE_T_CHAR);
 	return v->u.cval;
 }
 
@@ -2055,6 +2055,313 @@ static void shape_change_main(player_state * state)
 
 
 
+/**
+ * Set the player state flags implied by a set of object and curse flags.
+ * Used for racial intrinsics and for the combined equipment flags.
+ */
+static void apply_object_flags(player_state * state, const bitflag * flags_obj,
+							   const bitflag * flags_curse)
+{
+	/* Object flags */
+	if (of_has(flags_obj, OF_SUSTAIN_STR))
+		state->sustain_str = TRUE;
+	if (of_has(flags_obj, OF_SUSTAIN_INT))
+		state->sustain_int = TRUE;
+	if (of_has(flags_obj, OF_SUSTAIN_WIS))
+		state->sustain_wis = TRUE;
+	if (of_has(flags_obj, OF_SUSTAIN_DEX))
+		state->sustain_dex = TRUE;
+	if (of_has(flags_obj, OF_SUSTAIN_CON))
+		state->sustain_con = TRUE;
+	if (of_has(flags_obj, OF_SUSTAIN_CHR))
+		state->sustain_chr = TRUE;
+	if (of_has(flags_obj, OF_SLOW_DIGEST))
+		state->slow_digest = TRUE;
+	if (of_has(flags_obj, OF_FEATHER))
+		state->ffall = TRUE;
+	if (of_has(flags_obj, OF_LIGHT))
+		state->light = TRUE;
+	if (of_has(flags_obj, OF_REGEN))
+		state->regenerate = TRUE;
+	if (of_has(flags_obj, OF_TELEPATHY))
+		state->telepathy = TRUE;
+	if (of_has(flags_obj, OF_SEE_INVIS))
+		state->see_inv = TRUE;
+	if (of_has(flags_obj, OF_FREE_ACT))
+		state->free_act = TRUE;
+	if (of_has(flags_obj, OF_HOLD_LIFE))
+		state->hold_life = TRUE;
+	if (of_has(flags_obj, OF_BLESSED))
+		state->bless_blade = TRUE;
+	if (of_has(flags_obj, OF_IMPACT))
+		state->impact = TRUE;
+	if (of_has(flags_obj, OF_FEARLESS))
+		state->no_fear = TRUE;
+	if (of_has(flags_obj, OF_SEEING))
+		state->no_blind = TRUE;
+	if (of_has(flags_obj, OF_DARKNESS))
+		state->darkness = TRUE;
+
+	/* Curse flags */
+	if (cf_has(flags_curse, CF_TELEPORT))
+		state->teleport = TRUE;
+	if (cf_has(flags_curse, CF_NO_TELEPORT))
+		state->no_teleport = TRUE;
+	if (cf_has(flags_curse, CF_AGGRO_PERM))
+		state->aggravate = TRUE;
+	if (cf_has(flags_curse, CF_AGGRO_RAND))
+		state->rand_aggro = TRUE;
+	if (cf_has(flags_curse, CF_SLOW_REGEN))
+		state->slow_regen = TRUE;
+	if (cf_has(flags_curse, CF_AFRAID))
+		state->fear = TRUE;
+	if (cf_has(flags_curse, CF_HUNGRY))
+		state->fast_digest = TRUE;
+	if (cf_has(flags_curse, CF_POIS_RAND))
+		state->rand_pois = TRUE;
+	if (cf_has(flags_curse, CF_POIS_RAND_BAD))
+		state->rand_pois_bad = TRUE;
+	if (cf_has(flags_curse, CF_CUT_RAND))
+		state->rand_cuts = TRUE;
+	if (cf_has(flags_curse, CF_CUT_RAND_BAD))
+		state->rand_cuts_bad = TRUE;
+	if (cf_has(flags_curse, CF_HALLU_RAND))
+		state->rand_hallu = TRUE;
+	if (cf_has(flags_curse, CF_DROP_WEAPON))
+		state->drop_weapon = TRUE;
+	if (cf_has(flags_curse, CF_ATTRACT_DEMON))
+		state->attract_demon = TRUE;
+	if (cf_has(flags_curse, CF_ATTRACT_UNDEAD))
+		state->attract_undead = TRUE;
+	if (cf_has(flags_curse, CF_PARALYZE))
+		state->rand_paral = TRUE;
+	if (cf_has(flags_curse, CF_PARALYZE_ALL))
+		state->rand_paral_all = TRUE;
+	if (cf_has(flags_curse, CF_DRAIN_EXP))
+		state->drain_exp = TRUE;
+	if (cf_has(flags_curse, CF_DRAIN_MANA))
+		state->drain_mana = TRUE;
+	if (cf_has(flags_curse, CF_DRAIN_STAT))
+		state->drain_stat = TRUE;
+	if (cf_has(flags_curse, CF_DRAIN_CHARGE))
+		state->drain_charge = TRUE;
+}
+
+
+/**
+ * Everything about a worn object that its contribution to the player's
+ * state depends on.  Kept zeroed apart from the copied fields, so that two
+ * keys can be compared with memcmp().
+ */
+typedef struct slot_key {
+	s16b k_idx;
+	s16b weight;
+	s16b ac;
+	s16b to_h;
+	s16b to_d;
+	s16b to_a;
+	bitflag flags_obj[OF_SIZE];
+	bitflag flags_curse[CF_SIZE];
+	bitflag id_other[IF_SIZE];
+	int percent_res[MAX_P_RES];
+	int bonus_stat[A_MAX];
+	int bonus_other[MAX_P_BONUS];
+	bool shield_on_back;
+	bool shield_mast;
+	bool armor_mast;
+} slot_key;
+
+/**
+ * The contribution of one equipment slot to the player's state.
+ */
+typedef struct slot_bonus {
+	bool valid;
+	slot_key key;
+
+	int stat_add[A_MAX];
+	int stealth;
+	int search;
+	int infra;
+	int digging;
+	int speed;
+	int device;
+	int shots;
+	int might;
+
+	bitflag flags_obj[OF_SIZE];
+	bitflag flags_curse[CF_SIZE];
+
+	int ac;
+	int to_a;
+	int dis_to_a;
+	int to_h;
+	int to_d;
+	int dis_to_h;
+	int dis_to_d;
+} slot_bonus;
+
+/**
+ * Cached contributions of the player's real equipment, indexed from
+ * INVEN_WIELD.  A record is recomputed only when its key no longer matches
+ * the object in the slot.
+ */
+static slot_bonus slot_cache[INVEN_TOTAL - INVEN_WIELD];
+
+static void make_slot_key(slot_key * key, const object_type * o_ptr,
+						  int slot, bool shield_on_back)
+{
+	memset(key, 0, sizeof(*key));
+	key->k_idx = o_ptr->k_idx;
+	if (!o_ptr->k_idx)
+		return;
+
+	key->weight = o_ptr->weight;
+	key->ac = o_ptr->ac;
+	key->to_h = o_ptr->to_h;
+	key->to_d = o_ptr->to_d;
+	key->to_a = o_ptr->to_a;
+	of_copy(key->flags_obj, o_ptr->flags_obj);
+	cf_copy(key->flags_curse, o_ptr->flags_curse);
+	if_copy(key->id_other, o_ptr->id_other);
+	memcpy(key->percent_res, o_ptr->percent_res, sizeof(key->percent_res));
+	memcpy(key->bonus_stat, o_ptr->bonus_stat, sizeof(key->bonus_stat));
+	memcpy(key->bonus_other, o_ptr->bonus_other, sizeof(key->bonus_other));
+
+	/* Only the shield and body armour care about these */
+	if (slot == INVEN_ARM) {
+		key->shield_on_back = shield_on_back;
+		key->shield_mast = player_has(PF_SHIELD_MAST);
+	} else if (slot == INVEN_BODY) {
+		key->armor_mast = player_has(PF_ARMOR_MAST);
+	}
+}
+
+/**
+ * Work out what the object in equipment slot `slot` adds to the player's
+ * state.  Resistances are not included, since they are applied in sequence
+ * straight from the object.
+ */
+static void calc_slot_bonus(slot_bonus * b, const object_type * o_ptr, int slot,
+							bool shield_on_back)
+{
+	int j, temp_armour;
+
+	memset(b, 0, sizeof(*b));
+	make_slot_key(&b->key, o_ptr, slot, shield_on_back);
+	b->valid = TRUE;
+
+	/* Skip non-objects */
+	if (!o_ptr->k_idx)
+		return;
+
+	/* Affect stats */
+	for (j = 0; j < A_MAX; j++)
+		b->stat_add[j] = o_ptr->bonus_stat[j];
+
+	/* Affect stealth */
+	b->stealth = o_ptr->bonus_other[P_BONUS_STEALTH];
+
+	/* Affect searching ability and frequency (factor of five) */
+	b->search = o_ptr->bonus_other[P_BONUS_SEARCH] * 5;
+
+	/* Affect infravision */
+	b->infra = o_ptr->bonus_other[P_BONUS_INFRA];
+
+	/* Affect digging (factor of 20) */
+	b->digging = o_ptr->bonus_other[P_BONUS_TUNNEL] * 20;
+
+	/* Affect speed */
+	b->speed = o_ptr->bonus_other[P_BONUS_SPEED];
+
+	b->device = 10 * o_ptr->bonus_other[P_BONUS_M_MASTERY];
+
+	/* Affect shots.  Altered in Oangband. */
+	b->shots = o_ptr->bonus_other[P_BONUS_SHOTS];
+
+	/* Affect might.  Altered in Oangband. */
+	b->might = o_ptr->bonus_other[P_BONUS_MIGHT];
+
+	/* Object and curse flags */
+	of_copy(b->flags_obj, o_ptr->flags_obj);
+	cf_copy(b->flags_curse, o_ptr->flags_curse);
+
+	/* 
+	 * Modify the base armor class.   Shields worn on back are penalized. 
+	 * Shield and Armor masters benefit.
+	 */
+	if ((slot == INVEN_ARM) && (shield_on_back))
+		temp_armour = o_ptr->ac / 3;
+	else if ((slot == INVEN_ARM) && (player_has(PF_SHIELD_MAST)))
+		temp_armour = o_ptr->ac * 2;
+	else if ((slot == INVEN_BODY) && (player_has(PF_ARMOR_MAST)))
+		temp_armour = (o_ptr->ac * 5) / 3;
+	else
+		temp_armour = o_ptr->ac;
+
+	/* The base armor class is always known */
+	b->ac = temp_armour;
+
+	/* Apply the bonuses to armor class.  Shields worn on back are
+	 * penalized. */
+	if ((shield_on_back) && (slot == INVEN_ARM))
+		temp_armour = o_ptr->to_a / 2;
+	else
+		temp_armour = o_ptr->to_a;
+
+	b->to_a = temp_armour;
+
+	/* Apply the mental bonuses to armor class, if known */
+	if (if_has(o_ptr->id_other, IF_TO_A))
+		b->dis_to_a = temp_armour;
+
+	/* Hack -- do not apply "weapon" or "bow" bonuses */
+	if ((slot == INVEN_WIELD) || (slot == INVEN_BOW))
+		return;
+
+	/* Apply the bonuses to hit/damage */
+	b->to_h = o_ptr->to_h;
+	b->to_d = o_ptr->to_d;
+
+	/* Apply the mental bonuses tp hit/damage, if known */
+	if (if_has(o_ptr->id_other, IF_TO_H))
+		b->dis_to_h = o_ptr->to_h;
+	if (if_has(o_ptr->id_other, IF_TO_D))
+		b->dis_to_d = o_ptr->to_d;
+}
+
+/**
+ * Get the contribution of an equipment slot, using the cached record where
+ * the object is part of the player's real equipment.  Only an update of the
+ * player's own state may replace a stale record; anything else is worked
+ * out in `scratch`.
+ */
+static const slot_bonus *get_slot_bonus(const object_type * o_ptr, int slot,
+										bool shield_on_back, bool update,
+										slot_bonus * scratch)
+{
+	slot_bonus *b = &slot_cache[slot - INVEN_WIELD];
+	slot_key key;
+
+	/* Hypothetical objects never touch the cache */
+	if (o_ptr != &p_ptr->inventory[slot]) {
+		calc_slot_bonus(scratch, o_ptr, slot, shield_on_back);
+		return scratch;
+	}
+
+	make_slot_key(&key, o_ptr, slot, shield_on_back);
+	if (b->valid && !memcmp(&key, &b->key, sizeof(key)))
+		return b;
+
+	if (!update) {
+		calc_slot_bonus(scratch, o_ptr, slot, shield_on_back);
+		return scratch;
+	}
+
+	calc_slot_bonus(b, o_ptr, slot, shield_on_back);
+	return b;
+}
+
+
 /**
  * Calculate the players current "state", taking into account
  * not only race/class intrinsics, but also objects being worn
@@ -2083,19 +2390,20 @@ static void shape_change_main(player_state * state)
  *
  * This function induces various "status" messages.
  */
-extern void calc_bonuses(object_type inventory[], player_state * state,
-						 bool inspect)
+static void calc_bonuses_aux(object_type inventory[], player_state * state,
+							 int what_if_slot, const object_type * what_if)
 {
 	int i, j, hold;
 
-	int temp_armour;
-
 	int extra_shots = 0;
 	int extra_might = 0;
 
 	bool enhance = FALSE;
 
-	object_type *o_ptr;
+	const object_type *o_ptr;
+
+	bitflag f_obj[OF_SIZE];
+	bitflag f_curse[CF_SIZE];
 
 	/*** Reset ***/
 
@@ -2219,90 +2527,8 @@ extern void calc_bonuses(object_type inventory[], player_state * state,
 
 	/*** Analyze player ***/
 
-	/* Object flags */
-	if (of_has(rp_ptr->flags_obj, OF_SUSTAIN_STR))
-		state->sustain_str = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_SUSTAIN_INT))
-		state->sustain_int = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_SUSTAIN_WIS))
-		state->sustain_wis = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_SUSTAIN_DEX))
-		state->sustain_dex = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_SUSTAIN_CON))
-		state->sustain_con = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_SUSTAIN_CHR))
-		state->sustain_chr = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_SLOW_DIGEST))
-		state->slow_digest = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_FEATHER))
-		state->ffall = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_LIGHT))
-		state->light = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_REGEN))
-		state->regenerate = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_TELEPATHY))
-		state->telepathy = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_SEE_INVIS))
-		state->see_inv = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_FREE_ACT))
-		state->free_act = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_HOLD_LIFE))
-		state->hold_life = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_BLESSED))
-		state->bless_blade = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_IMPACT))
-		state->impact = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_FEARLESS))
-		state->no_fear = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_SEEING))
-		state->no_blind = TRUE;
-	if (of_has(rp_ptr->flags_obj, OF_DARKNESS))
-		state->darkness = TRUE;
-
-
-	/* Curse flags */
-	if (cf_has(rp_ptr->flags_curse, CF_TELEPORT))
-		state->teleport = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_NO_TELEPORT))
-		state->no_teleport = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_AGGRO_PERM))
-		state->aggravate = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_AGGRO_RAND))
-		state->rand_aggro = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_SLOW_REGEN))
-		state->slow_regen = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_AFRAID))
-		state->fear = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_HUNGRY))
-		state->fast_digest = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_POIS_RAND))
-		state->rand_pois = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_POIS_RAND_BAD))
-		state->rand_pois_bad = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_CUT_RAND))
-		state->rand_cuts = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_CUT_RAND_BAD))
-		state->rand_cuts_bad = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_HALLU_RAND))
-		state->rand_hallu = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_DROP_WEAPON))
-		state->drop_weapon = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_ATTRACT_DEMON))
-		state->attract_demon = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_ATTRACT_UNDEAD))
-		state->attract_undead = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_PARALYZE))
-		state->rand_paral = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_PARALYZE_ALL))
-		state->rand_paral_all = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_DRAIN_EXP))
-		state->drain_exp = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_DRAIN_MANA))
-		state->drain_mana = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_DRAIN_STAT))
-		state->drain_stat = TRUE;
-	if (cf_has(rp_ptr->flags_curse, CF_DRAIN_CHARGE))
-		state->drain_charge = TRUE;
+	/* Object and curse flags */
+	apply_object_flags(state, rp_ptr->flags_obj, rp_ptr->flags_curse);
 
 	/* Resistances */
 	for (i = 0; i < MAX_P_RES; i++) {
@@ -2364,133 +2590,45 @@ extern void calc_bonuses(object_type inventory[], player_state * state,
 
   /*** Analyze equipment ***/
 
-	/* Scan the equipment */
+	of_wipe(f_obj);
+	cf_wipe(f_curse);
+
+	/* Fold in the contribution of each slot */
 	for (i = INVEN_WIELD; i < INVEN_TOTAL; i++) {
-		//  o_ptr = &p_ptr->inventory[i];
-		o_ptr = &(inventory[i]);
+		slot_bonus scratch;
+		const slot_bonus *b;
+
+		o_ptr = (i == what_if_slot) ? what_if : &inventory[i];
+
 		/* Skip non-objects */
 		if (!o_ptr->k_idx)
 			continue;
 
+		b = get_slot_bonus(o_ptr, i, state->shield_on_back,
+						   state == &p_ptr->state, &scratch);
+
 		/* Affect stats */
 		for (j = 0; j < A_MAX; j++)
-			state->stat_add[j] += o_ptr->bonus_stat[j];
-
-		/* Affect stealth */
-		state->skills[SKILL_STEALTH] +=
-			o_ptr->bonus_other[P_BONUS_STEALTH];
-
-		/* Affect searching ability (factor of five) */
-		state->skills[SKILL_SEARCH] +=
-			(o_ptr->bonus_other[P_BONUS_SEARCH] * 5);
-
-		/* Affect searching frequency (factor of five) */
-		state->skills[SKILL_SEARCH_FREQUENCY] +=
-			(o_ptr->bonus_other[P_BONUS_SEARCH] * 5);
-
-		/* Affect infravision */
-		state->see_infra += o_ptr->bonus_other[P_BONUS_INFRA];
-
-		/* Affect digging (factor of 20) */
-		state->skills[SKILL_DIGGING] +=
-			(o_ptr->bonus_other[P_BONUS_TUNNEL] * 20);
-
-		/* Affect speed */
-		state->pspeed += o_ptr->bonus_other[P_BONUS_SPEED];
-
-		state->skills[SKILL_DEVICE] +=
-			10 * o_ptr->bonus_other[P_BONUS_M_MASTERY];
-
-		/* Affect shots.  Altered in Oangband. */
-		extra_shots += o_ptr->bonus_other[P_BONUS_SHOTS];
-
-		/* Affect might.  Altered in Oangband. */
-		extra_might += o_ptr->bonus_other[P_BONUS_MIGHT];
-
-		/* Object flags */
-		if (of_has(o_ptr->flags_obj, OF_SUSTAIN_STR))
-			state->sustain_str = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_SUSTAIN_INT))
-			state->sustain_int = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_SUSTAIN_WIS))
-			state->sustain_wis = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_SUSTAIN_DEX))
-			state->sustain_dex = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_SUSTAIN_CON))
-			state->sustain_con = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_SUSTAIN_CHR))
-			state->sustain_chr = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_SLOW_DIGEST))
-			state->slow_digest = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_FEATHER))
-			state->ffall = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_LIGHT))
-			state->light = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_REGEN))
-			state->regenerate = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_TELEPATHY))
-			state->telepathy = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_SEE_INVIS))
-			state->see_inv = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_FREE_ACT))
-			state->free_act = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_HOLD_LIFE))
-			state->hold_life = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_FEARLESS))
-			state->no_fear = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_SEEING))
-			state->no_blind = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_IMPACT))
-			state->impact = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_BLESSED))
-			state->bless_blade = TRUE;
-		if (of_has(o_ptr->flags_obj, OF_DARKNESS))
-			state->darkness = TRUE;
-
-		/* Bad flags */
-		if (cf_has(o_ptr->flags_curse, CF_TELEPORT))
-			state->teleport = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_NO_TELEPORT))
-			state->no_teleport = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_AGGRO_PERM))
-			state->aggravate = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_AGGRO_RAND))
-			state->rand_aggro = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_SLOW_REGEN))
-			state->slow_regen = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_AFRAID))
-			state->fear = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_HUNGRY))
-			state->fast_digest = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_POIS_RAND))
-			state->rand_pois = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_POIS_RAND_BAD))
-			state->rand_pois_bad = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_CUT_RAND))
-			state->rand_cuts = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_CUT_RAND_BAD))
-			state->rand_cuts_bad = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_HALLU_RAND))
-			state->rand_hallu = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_DROP_WEAPON))
-			state->drop_weapon = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_ATTRACT_DEMON))
-			state->attract_demon = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_ATTRACT_UNDEAD))
-			state->attract_undead = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_PARALYZE))
-			state->rand_paral = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_PARALYZE_ALL))
-			state->rand_paral_all = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_DRAIN_EXP))
-			state->drain_exp = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_DRAIN_MANA))
-			state->drain_mana = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_DRAIN_STAT))
-			state->drain_stat = TRUE;
-		if (cf_has(o_ptr->flags_curse, CF_DRAIN_CHARGE))
-			state->drain_charge = TRUE;
+			state->stat_add[j] += b->stat_add[j];
+
+		/* Affect skills */
+		state->skills[SKILL_STEALTH] += b->stealth;
+		state->skills[SKILL_SEARCH] += b->search;
+		state->skills[SKILL_SEARCH_FREQUENCY] += b->search;
+		state->skills[SKILL_DIGGING] += b->digging;
+		state->skills[SKILL_DEVICE] += b->device;
+
+		/* Affect infravision and speed */
+		state->see_infra += b->infra;
+		state->pspeed += b->speed;
+
+		/* Affect shots and might */
+		extra_shots += b->shots;
+		extra_might += b->might;
 
+		/* Collect flags */
+		of_union(f_obj, b->flags_obj);
+		cf_union(f_curse, b->flags_curse);
 
 		for (j = 0; j < MAX_P_RES; j++)
 			apply_resist(&state->res_list[j], o_ptr->percent_res[j]);
@@ -2503,56 +2641,22 @@ extern void calc_bonuses(object_type inventory[], player_state * state,
 		/* End item resistances; do bounds check on resistance levels */
 		resistance_limits(state);
 
-		/* 
-		 * Modify the base armor class.   Shields worn on back are penalized. 
-		 * Shield and Armor masters benefit.
-		 */
-		if ((i == INVEN_ARM) && (state->shield_on_back))
-			temp_armour = o_ptr->ac / 3;
-		else if ((i == INVEN_ARM) && (player_has(PF_SHIELD_MAST)))
-			temp_armour = o_ptr->ac * 2;
-		else if ((i == INVEN_BODY) && (player_has(PF_ARMOR_MAST)))
-			temp_armour = (o_ptr->ac * 5) / 3;
-		else
-			temp_armour = o_ptr->ac;
-
-		state->ac += temp_armour;
-
-		/* The base armor class is always known */
-		state->dis_ac += temp_armour;
-
-		/* Apply the bonuses to armor class.  Shields worn on back are
-		 * penalized. */
-		if ((state->shield_on_back) && (i == INVEN_ARM))
-			temp_armour = o_ptr->to_a / 2;
-		else
-			temp_armour = o_ptr->to_a;
-
-		state->to_a += temp_armour;
+		/* Armour class; the base armor class is always known */
+		state->ac += b->ac;
+		state->dis_ac += b->ac;
+		state->to_a += b->to_a;
+		state->dis_to_a += b->dis_to_a;
 
-		/* Apply the mental bonuses to armor class, if known */
-		if (if_has(o_ptr->id_other, IF_TO_A))
-			state->dis_to_a += temp_armour;
-
-		/* Hack -- do not apply "weapon" bonuses */
-		if (i == INVEN_WIELD)
-			continue;
-
-		/* Hack -- do not apply "bow" bonuses */
-		if (i == INVEN_BOW)
-			continue;
-
-		/* Apply the bonuses to hit/damage */
-		state->to_h += o_ptr->to_h;
-		state->to_d += o_ptr->to_d;
-
-		/* Apply the mental bonuses tp hit/damage, if known */
-		if (if_has(o_ptr->id_other, IF_TO_H))
-			state->dis_to_h += o_ptr->to_h;
-		if (if_has(o_ptr->id_other, IF_TO_D))
-			state->dis_to_d += o_ptr->to_d;
+		/* Bonuses to hit/damage */
+		state->to_h += b->to_h;
+		state->to_d += b->to_d;
+		state->dis_to_h += b->dis_to_h;
+		state->dis_to_d += b->dis_to_d;
 	}
 
+	/* Apply the equipment flags */
+	apply_object_flags(state, f_obj, f_curse);
+
 	/* Hack -- clear a few flags for certain races. */
 
 	/* The dark elf's saving grace */
@@ -3036,8 +3140,7 @@ extern void calc_bonuses(object_type inventory[], player_state * state,
   /*** Analyze current bow ***/
 
 	/* Examine the "current bow" */
-	//o_ptr = &p_ptr->inventory[INVEN_BOW];
-	o_ptr = &(inventory[INVEN_BOW]);
+	o_ptr = (what_if_slot == INVEN_BOW) ? what_if : &inventory[INVEN_BOW];
 	/* Assume not heavy */
 	state->heavy_shoot = FALSE;
 
@@ -3159,8 +3262,7 @@ extern void calc_bonuses(object_type inventory[], player_state * state,
   /*** Analyze weapon ***/
 
 	/* Examine the "current weapon" */
-	//o_ptr = &p_ptr->inventory[INVEN_WIELD];
-	o_ptr = &(inventory[INVEN_WIELD]);
+	o_ptr = (what_if_slot == INVEN_WIELD) ? what_if : &inventory[INVEN_WIELD];
 
 	/* Assume that the player is not a Priest wielding an edged weapon. */
 	state->icky_wield = FALSE;
@@ -3231,6 +3333,28 @@ extern void calc_bonuses(object_type inventory[], player_state * state,
 
 }
 
+/**
+ * Calculate the player's state, with `inventory` as their equipment.
+ */
+extern void calc_bonuses(object_type inventory[], player_state * state,
+						 bool inspect)
+{
+	calc_bonuses_aux(inventory, state, -1, NULL);
+}
+
+/**
+ * Calculate the state the player would have with `o_ptr` in equipment slot
+ * `slot` instead of whatever is there now.  Only the hypothetical slot is
+ * analysed afresh; the rest of the equipment comes from the slot cache.
+ *
+ * As with calc_bonuses(), `state->shield_on_back` is an input.
+ */
+void calc_bonuses_what_if(const object_type * o_ptr, int slot,
+						  player_state * state)
+{
+	calc_bonuses_aux(p_ptr->inventory, state, slot, o_ptr);
+}
+
 /*
  * Calculate bonuses, and print various things on changes.
  */
@@ -3240,6 +3364,7 @@ static void update_bonuses(void)
 
 	player_state *state = &p_ptr->state;
 	player_state old = p_ptr->state;
+	u32b old_redraw = p_ptr->redraw;
 	object_type *o_ptr;
 
 	/*** Calculate bonuses ***/
@@ -3446,8 +3571,9 @@ static void update_bonuses(void)
 		old.shield_on_back = state->shield_on_back;
 	}
 
-	/* Hack - force redraw if stuff has changed */
-	if (p_ptr->redraw)
+	/* Hack - force redraw if stuff has changed (here, not just since the
+	 * last redraw, which may be put off while running or resting) */
+	if (p_ptr->redraw & ~old_redraw)
 		p_ptr->update |= (PU_BONUS);
 }
 
@@ -3634,6 +3760,8 @@ void redraw_stuff(struct player *p)
 	if (character_icky)
 		return;
 
+	PROF_BEGIN(REDRAW_STUFF);
+
 	/* For each listed flag, send the appropriate signal to the UI */
 	for (i = 0; i < N_ELEMENTS(redraw_events); i++) {
 		const struct flag_event_trigger *hnd = &redraw_events[i];
@@ -3644,6 +3772,10 @@ void redraw_stuff(struct player *p)
 
 	/* Then the ones that require parameters to be supplied. */
 	if (p_ptr->redraw & PR_MAP) {
+		/* Anything on the map may look different */
+		forget_map_glyphs();
+	}
+	if (p_ptr->redraw & (PR_MAP | PR_PANEL)) {
 		/* Mark the whole map to be redrawn */
 		event_signal_point(EVENT_MAP, -1, -1);
 	}
@@ -3655,6 +3787,8 @@ void redraw_stuff(struct player *p)
 	 * is over.
 	 */
 	event_signal(EVENT_END);
+
+	PROF_END(REDRAW_STUFF);
 }
 
 
@@ -841,6 +841,8 @@ extern const byte adj_dex_safe[STAT_RANGE];
 
 extern void apply_resist(int *player_resist, int item_resist);
 void calc_bonuses(object_type inventory[], player_state *state, bool id_only);
+void calc_bonuses_what_if(const object_type *o_ptr, int slot,
+						  player_state *state);
 int calc_blows(const object_type *o_ptr, player_state *state, int extra_blows);
 void notice_stuff(struct player *p);
 void update_stuff(struct player *p);
@@ -4106,6 +4106,7 @@ static void name_artifact(int a_idx)
 	}
 
 	/* Insert whatever name is created or found into the temporary array. */
+	string_free(a_info[a_idx].name);
 	a_info[a_idx].name = string_make(word);
 }
 
@@ -4140,12 +4141,11 @@ static void design_random_artifact(int a_idx)
 
 
 /**
- * Initialize all the random artifacts in the artifact array.  This function 
- * is only called when a player is born.  Because various sub-functions use 
- * player information, it must be called after the player has been generated 
- * and player information has been loaded.
+ * Design all the random artifacts in the artifact array, noting for each 
+ * the potential it was granted and how much of that was left unspent.  
+ * Either array may be NULL; otherwise both are indexed by artifact.
  */
-void initialize_random_artifacts(void)
+void design_random_artifacts(int *granted, int *unspent)
 {
 	/* Index of the artifact currently being initialized. */
 	int a_idx;
@@ -4157,5 +4157,23 @@ void initialize_random_artifacts(void)
 
 		/* Design the artifact, storing information as we go along. */
 		design_random_artifact(a_idx);
+
+		/* Account for the potential */
+		if (granted)
+			granted[a_idx] = initial_potential;
+		if (unspent)
+			unspent[a_idx] = potential;
 	}
 }
+
+
+/**
+ * Initialize all the random artifacts in the artifact array.  This function 
+ * is only called when a player is born.  Because various sub-functions use 
+ * player information, it must be called after the player has been generated 
+ * and player information has been loaded.
+ */
+void initialize_random_artifacts(void)
+{
+	design_random_artifacts(NULL, NULL);
+}
@@ -151,8 +151,8 @@ static void wr_monster(monster_type * m_ptr)
 	wr_s16b(m_ptr->hp);
 	wr_s16b(m_ptr->maxhp);
 	wr_s16b(m_ptr->csleep);
-	wr_byte(m_ptr->mspeed);
-	wr_byte(m_ptr->energy);
+	wr_byte(mon_speed(m_ptr));
+	wr_byte(mon_energy(m_ptr));
 	wr_byte(m_ptr->stunned);
 	wr_byte(m_ptr->confused);
 	wr_byte(m_ptr->monfear);
@@ -852,8 +852,8 @@ void wr_stores(void)
 				wr_s16b(st_ptr->table[j]);
 			}
 
-		/* Expansion */
-		wr_u32b(0);
+		/* Save the turnovers owed */
+		wr_u32b(st_ptr->maint_due);
 	}
 }
 
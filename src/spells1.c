@@ -1185,9 +1185,9 @@ bool chaotic_effects(monster_type * m_ptr)
 
 			/* If it fails, slow down if not already slowed. */
 			else {
-				if (m_ptr->mspeed > 60) {
-					if (r_ptr->speed - m_ptr->mspeed <= 10) {
-						m_ptr->mspeed -= 10;
+				if (mon_speed(m_ptr) > 60) {
+					if (r_ptr->speed - mon_speed(m_ptr) <= 10) {
+						mon_speed(m_ptr) -= 10;
 						msg("%s starts moving slower.", m_name);
 					}
 				}
@@ -1199,8 +1199,8 @@ bool chaotic_effects(monster_type * m_ptr)
 	case 11:
 		{
 			/* Speed up */
-			if (m_ptr->mspeed < 150)
-				m_ptr->mspeed += 10;
+			if (mon_speed(m_ptr) < 150)
+				mon_speed(m_ptr) += 10;
 			msg("%s starts moving faster.", m_name);
 
 			return (TRUE);
@@ -4786,8 +4786,8 @@ static bool project_m(int who, int y, int x, int dam, int typ, int flg)
 			m_ptr->hp = m_ptr->maxhp;
 
 			/* Speed up.  Bonus to speed reduced in Oangband. */
-			if (m_ptr->mspeed < 150)
-				m_ptr->mspeed += 5;
+			if (mon_speed(m_ptr) < 150)
+				mon_speed(m_ptr) += 5;
 
 			/* Attempt to clone. */
 			if (multiply_monster(cave_m_idx[y][x])) {
@@ -4837,8 +4837,8 @@ static bool project_m(int who, int y, int x, int dam, int typ, int flg)
 				obvious = TRUE;
 
 			/* Speed up */
-			if (m_ptr->mspeed < 150)
-				m_ptr->mspeed += 10;
+			if (mon_speed(m_ptr) < 150)
+				mon_speed(m_ptr) += 10;
 			note = " starts moving faster.";
 
 			/* No "real" damage */
@@ -4882,9 +4882,9 @@ static bool project_m(int who, int y, int x, int dam, int typ, int flg)
 
 			/* If it fails, slow down if not already slowed. */
 			else {
-				if (m_ptr->mspeed > 60) {
-					if (r_ptr->speed - m_ptr->mspeed <= 10) {
-						m_ptr->mspeed -= 10;
+				if (mon_speed(m_ptr) > 60) {
+					if (r_ptr->speed - mon_speed(m_ptr) <= 10) {
+						mon_speed(m_ptr) -= 10;
 						note = " starts moving slower.";
 					}
 				}
@@ -8071,6 +8071,8 @@ bool project(int who, int rad, int y, int x, int dam, int typ, int flg,
 	/* Precalculated damage values for each distance. */
 	int *dam_at_dist = malloc((MAX_RANGE + 1) * sizeof(*dam_at_dist));
 
+	PROF_BEGIN(PROJECT);
+
 	/* Hack -- Flush any pending output */
 	handle_stuff(p_ptr);
 
@@ -8635,6 +8637,8 @@ bool project(int who, int rad, int y, int x, int dam, int typ, int flg,
 
 	free(dam_at_dist);
 
+	PROF_END(PROJECT);
+
 	/* Return "something was noticed" */
 	return (notice);
 }
@@ -1812,11 +1812,13 @@ bool detect_treasure(int range, bool show)
  */
 bool detect_objects_gold(int range, bool show)
 {
-	int i, y, x;
+	int k, n, y, x;
 
 	int py = p_ptr->py;
 	int px = p_ptr->px;
 
+	s16b *found = C_ZNEW(o_max, s16b);
+
 	int num = 0;
 
 	bool detect = FALSE;
@@ -1825,9 +1827,10 @@ bool detect_objects_gold(int range, bool show)
 	if (show)
 		animate_detect(range);
 
-	/* Scan objects */
-	for (i = 1; i < o_max; i++) {
-		object_type *o_ptr = &o_list[i];
+	/* Scan objects near the player */
+	n = region_scan(&obj_regions, py, px, range, found);
+	for (k = 0; k < n; k++) {
+		object_type *o_ptr = &o_list[found[k]];
 
 		/* Skip dead objects */
 		if (!o_ptr->k_idx)
@@ -1849,6 +1852,7 @@ bool detect_objects_gold(int range, bool show)
 		if (o_ptr->tval == TV_GOLD) {
 			/* Hack -- memorize it */
 			o_ptr->marked = TRUE;
+			obj_seen_add(found[k]);
 
 			/* Redraw */
 			light_spot(y, x);
@@ -1867,6 +1871,8 @@ bool detect_objects_gold(int range, bool show)
 
 	}
 
+	FREE(found);
+
 	/* Result */
 	return (detect);
 
@@ -1878,11 +1884,13 @@ bool detect_objects_gold(int range, bool show)
  */
 bool detect_objects_normal(int range, bool show)
 {
-	int i, y, x;
+	int k, n, y, x;
 
 	int py = p_ptr->py;
 	int px = p_ptr->px;
 
+	s16b *found = C_ZNEW(o_max, s16b);
+
 	int num = 0;
 
 	bool detect = FALSE;
@@ -1891,9 +1899,10 @@ bool detect_objects_normal(int range, bool show)
 	if (show)
 		animate_detect(range);
 
-	/* Scan objects */
-	for (i = 1; i < o_max; i++) {
-		object_type *o_ptr = &o_list[i];
+	/* Scan objects near the player */
+	n = region_scan(&obj_regions, py, px, range, found);
+	for (k = 0; k < n; k++) {
+		object_type *o_ptr = &o_list[found[k]];
 
 		/* Skip dead objects */
 		if (!o_ptr->k_idx)
@@ -1915,6 +1924,7 @@ bool detect_objects_normal(int range, bool show)
 		if (o_ptr->tval != TV_GOLD) {
 			/* Hack -- memorize it */
 			o_ptr->marked = TRUE;
+			obj_seen_add(found[k]);
 
 			/* Redraw */
 			light_spot(y, x);
@@ -1937,6 +1947,8 @@ bool detect_objects_normal(int range, bool show)
 
 	}
 
+	FREE(found);
+
 	/* Result */
 	return (detect);
 }
@@ -1953,11 +1965,13 @@ bool detect_objects_normal(int range, bool show)
  */
 bool detect_objects_magic(int range, bool show)
 {
-	int i, y, x, tv;
+	int k, n, y, x, tv;
 
 	int py = p_ptr->py;
 	int px = p_ptr->px;
 
+	s16b *found = C_ZNEW(o_max, s16b);
+
 	bool detect = FALSE;
 
 	int num = 0;
@@ -1966,9 +1980,10 @@ bool detect_objects_magic(int range, bool show)
 	if (show)
 		animate_detect(range);
 
-	/* Scan all objects */
-	for (i = 1; i < o_max; i++) {
-		object_type *o_ptr = &o_list[i];
+	/* Scan objects near the player */
+	n = region_scan(&obj_regions, py, px, range, found);
+	for (k = 0; k < n; k++) {
+		object_type *o_ptr = &o_list[found[k]];
 
 		/* Skip dead objects */
 		if (!o_ptr->k_idx)
@@ -1998,6 +2013,7 @@ bool detect_objects_magic(int range, bool show)
 			|| ((o_ptr->to_a > 0) || (o_ptr->to_h + o_ptr->to_d > 0))) {
 			/* Memorize the item */
 			o_ptr->marked = TRUE;
+			obj_seen_add(found[k]);
 
 			/* Redraw */
 			light_spot(y, x);
@@ -2020,6 +2036,8 @@ bool detect_objects_magic(int range, bool show)
 
 	}
 
+	FREE(found);
+
 	/* Return result */
 	return (detect);
 }
@@ -2030,11 +2048,13 @@ bool detect_objects_magic(int range, bool show)
  */
 bool detect_monsters_normal(int range, bool show)
 {
-	int i, y, x;
+	int k, n, y, x;
 
 	int py = p_ptr->py;
 	int px = p_ptr->px;
 
+	s16b *found = C_ZNEW(m_max, s16b);
+
 	bool flag = FALSE;
 
 	int num = 0;
@@ -2044,9 +2064,10 @@ bool detect_monsters_normal(int range, bool show)
 	if (show)
 		animate_detect(range);
 
-	/* Scan monsters */
-	for (i = 1; i < m_max; i++) {
-		monster_type *m_ptr = &m_list[i];
+	/* Scan monsters near the player */
+	n = region_scan(&mon_regions, py, px, range, found);
+	for (k = 0; k < n; k++) {
+		monster_type *m_ptr = &m_list[found[k]];
 		monster_race *r_ptr = &r_info[m_ptr->r_idx];
 
 		/* Skip dead monsters */
@@ -2070,7 +2091,7 @@ bool detect_monsters_normal(int range, bool show)
 			m_ptr->mflag |= (MFLAG_MARK | MFLAG_SHOW);
 
 			/* Update the monster */
-			update_mon(i, FALSE);
+			update_mon(found[k], FALSE);
 
 			/* increment number found */
 			num++;
@@ -2095,6 +2116,8 @@ bool detect_monsters_normal(int range, bool show)
 			msg("You detect monsters.");
 	}
 
+	FREE(found);
+
 	/* Result */
 	return (flag);
 }
@@ -2105,11 +2128,13 @@ bool detect_monsters_normal(int range, bool show)
  */
 bool detect_monsters_invis(int range, bool show)
 {
-	int i, y, x;
+	int k, n, y, x;
 
 	int py = p_ptr->py;
 	int px = p_ptr->px;
 
+	s16b *found = C_ZNEW(m_max, s16b);
+
 	bool flag = FALSE;
 
 	int num = 0;
@@ -2119,9 +2144,10 @@ bool detect_monsters_invis(int range, bool show)
 	if (show)
 		animate_detect(range);
 
-	/* Scan monsters */
-	for (i = 1; i < m_max; i++) {
-		monster_type *m_ptr = &m_list[i];
+	/* Scan monsters near the player */
+	n = region_scan(&mon_regions, py, px, range, found);
+	for (k = 0; k < n; k++) {
+		monster_type *m_ptr = &m_list[found[k]];
 		monster_race *r_ptr = &r_info[m_ptr->r_idx];
 		monster_lore *l_ptr = &l_list[m_ptr->r_idx];
 
@@ -2155,7 +2181,7 @@ bool detect_monsters_invis(int range, bool show)
 			m_ptr->mflag |= (MFLAG_MARK | MFLAG_SHOW);
 
 			/* Update the monster */
-			update_mon(i, FALSE);
+			update_mon(found[k], FALSE);
 
 			/* increment number found */
 			num++;
@@ -2180,6 +2206,8 @@ bool detect_monsters_invis(int range, bool show)
 			msg("You detect invisible creatures.");
 	}
 
+	FREE(found);
+
 	/* Result */
 	return (flag);
 }
@@ -2191,11 +2219,13 @@ bool detect_monsters_invis(int range, bool show)
  */
 bool detect_monsters_evil(int range, bool show)
 {
-	int i, y, x;
+	int k, n, y, x;
 
 	int py = p_ptr->py;
 	int px = p_ptr->px;
 
+	s16b *found = C_ZNEW(m_max, s16b);
+
 	bool flag = FALSE;
 
 	int num = 0;
@@ -2205,9 +2235,10 @@ bool detect_monsters_evil(int range, bool show)
 	if (show)
 		animate_detect(range);
 
-	/* Scan monsters */
-	for (i = 1; i < m_max; i++) {
-		monster_type *m_ptr = &m_list[i];
+	/* Scan monsters near the player */
+	n = region_scan(&mon_regions, py, px, range, found);
+	for (k = 0; k < n; k++) {
+		monster_type *m_ptr = &m_list[found[k]];
 		monster_race *r_ptr = &r_info[m_ptr->r_idx];
 		monster_lore *l_ptr = &l_list[m_ptr->r_idx];
 
@@ -2241,7 +2272,7 @@ bool detect_monsters_evil(int range, bool show)
 			m_ptr->mflag |= (MFLAG_MARK | MFLAG_SHOW);
 
 			/* Update the monster */
-			update_mon(i, FALSE);
+			update_mon(found[k], FALSE);
 
 			/* increment number found */
 			num++;
@@ -2267,6 +2298,8 @@ bool detect_monsters_evil(int range, bool show)
 
 	}
 
+	FREE(found);
+
 	/* Result */
 	return (flag);
 
@@ -2279,11 +2312,13 @@ bool detect_monsters_evil(int range, bool show)
  */
 bool detect_monsters_living(int range, bool show)
 {
-	int i, y, x;
+	int k, n, y, x;
 
 	int py = p_ptr->py;
 	int px = p_ptr->px;
 
+	s16b *found = C_ZNEW(m_max, s16b);
+
 	bool flag = FALSE;
 
 	int num = 0;
@@ -2293,9 +2328,10 @@ bool detect_monsters_living(int range, bool show)
 	if (show)
 		animate_detect(range);
 
-	/* Scan monsters */
-	for (i = 1; i < m_max; i++) {
-		monster_type *m_ptr = &m_list[i];
+	/* Scan monsters near the player */
+	n = region_scan(&mon_regions, py, px, range, found);
+	for (k = 0; k < n; k++) {
+		monster_type *m_ptr = &m_list[found[k]];
 		monster_race *r_ptr = &r_info[m_ptr->r_idx];
 
 		/* Skip dead monsters */
@@ -2320,7 +2356,7 @@ bool detect_monsters_living(int range, bool show)
 			m_ptr->mflag |= (MFLAG_MARK | MFLAG_SHOW);
 
 			/* Update the monster */
-			update_mon(i, FALSE);
+			update_mon(found[k], FALSE);
 
 			/* increment number found */
 			num++;
@@ -2386,6 +2422,8 @@ bool detect_monsters_living(int range, bool show)
 	}
 
 
+	FREE(found);
+
 	/* Result */
 	return (flag);
 }
@@ -4401,8 +4439,8 @@ bool aggravate_monsters(int who, bool the_entire_level)
 			m_ptr->mflag |= (MFLAG_ACTV);
 
 			/* Get mad. */
-			if (m_ptr->mspeed < r_ptr->speed + 10)
-				m_ptr->mspeed = r_ptr->speed + 10;
+			if (mon_speed(m_ptr) < r_ptr->speed + 10)
+				mon_speed(m_ptr) = r_ptr->speed + 10;
 		}
 
 		/* Standard aggravation */
@@ -4425,8 +4463,8 @@ bool aggravate_monsters(int who, bool the_entire_level)
 					m_ptr->mflag |= (MFLAG_ACTV);
 
 					/* Get mad. */
-					if (m_ptr->mspeed < r_ptr->speed + 10)
-						m_ptr->mspeed = r_ptr->speed + 10;
+					if (mon_speed(m_ptr) < r_ptr->speed + 10)
+						mon_speed(m_ptr) = r_ptr->speed + 10;
 				}
 
 				/* Know we've aggravated */
@@ -1858,8 +1858,6 @@ static void store_purchase(void)
 
 			/* Store is empty */
 			if (st_ptr->stock_num == 0) {
-				int i;
-
 				/* Shuffle.  Made retiring more likely. */
 				if (randint0(STORE_SHUFFLE) < 5) {
 					/* Message */
@@ -1876,10 +1874,7 @@ static void store_purchase(void)
 				}
 
 				/* New inventory */
-				for (i = 0; i < 10; ++i) {
-					/* Maintain the store */
-					store_maint(store_num);
-				}
+				store_maint(store_num, STORE_MAINT_MAX);
 
 				/* Start over */
 				store_top = 0;
@@ -2810,6 +2805,7 @@ static void store_process_command(ui_event ke)
 
 	event_signal(EVENT_INVENTORY);
 	event_signal(EVENT_EQUIPMENT);
+	event_signal(EVENT_END);
 
 	/* Notice and handle stuff */
 	notice_stuff(p_ptr);
@@ -2887,6 +2883,53 @@ void get_owner(bool pick)
 	ot_ptr = &b_info[(type * z_info->b_max) + st_ptr->owner];
 }
 
+/**
+ * Do any turnovers a store is owed.
+ */
+static void store_maint_owed(int which)
+{
+	int rounds = store[which].maint_due;
+
+	if (!rounds)
+		return;
+
+	store[which].maint_due = 0;
+	store_maint(which, rounds);
+}
+
+/**
+ * Bring a store up to date with the turnovers it missed while the player
+ * was away.  The black market goes after the rest of its town, since it
+ * turns away anything the other stores have in stock.
+ */
+static void store_catch_up(int which)
+{
+	int n, base, max_stores;
+	int old_town = town;
+
+	/* Find the town */
+	if (which < NUM_TOWNS_SMALL * MAX_STORES_SMALL) {
+		town = which / MAX_STORES_SMALL;
+		base = town * MAX_STORES_SMALL;
+		max_stores = MAX_STORES_SMALL;
+	} else {
+		n = (which - NUM_TOWNS_SMALL * MAX_STORES_SMALL) / MAX_STORES_BIG;
+		town = NUM_TOWNS_SMALL + n;
+		base = NUM_TOWNS_SMALL * MAX_STORES_SMALL + n * MAX_STORES_BIG;
+		max_stores = MAX_STORES_BIG;
+	}
+
+	/* The black market needs the rest of the town done first */
+	if (store[which].type == STORE_BLACKM)
+		for (n = 0; n < max_stores; n++)
+			if (base + n != which)
+				store_maint_owed(base + n);
+
+	store_maint_owed(which);
+
+	town = old_town;
+}
+
 /**
  * Enter a store, and interact with it.
  *
@@ -2995,6 +3038,9 @@ void do_cmd_store(cmd_code code, cmd_arg args[])
 		return;
 	}
 
+	/* Restock for the days the player was away */
+	store_catch_up(which);
+
 	/* Forget the view */
 	forget_view();
 
@@ -3233,10 +3279,14 @@ void store_shuffle(int which)
 
 /**
  * Maintain the inventory at the stores.
+ *
+ * Several days' turnover can be done in one pass: the sales of every day
+ * are taken at once, then the shelves are filled as they would be at the
+ * end of the last day.
  */
-void store_maint(int which)
+void store_maint(int which, int rounds)
 {
-	int j;
+	int i, j;
 	int giveup = 0;
 	int old_rating = rating;
 
@@ -3274,8 +3324,9 @@ void store_maint(int which)
 	/* Choose the number of slots to keep */
 	j = st_ptr->stock_num;
 
-	/* Sell a few items */
-	j = j - randint1(STORE_TURNOVER);
+	/* Sell a few items each day */
+	for (i = 0; i < rounds; i++)
+		j = j - randint1(STORE_TURNOVER);
 
 	/* Never keep more than "STORE_MAX_KEEP" slots */
 	if (j > STORE_MAX_KEEP)
@@ -3297,6 +3348,10 @@ void store_maint(int which)
 	/* Choose the number of slots to fill */
 	j = st_ptr->stock_num;
 
+	/* The days before the last one kept the shelves minimally stocked */
+	if ((rounds > 1) && (j < STORE_MIN_KEEP))
+		j = STORE_MIN_KEEP;
+
 	/* Buy some more items */
 	j = j + randint1(STORE_TURNOVER);
 
@@ -3316,7 +3371,6 @@ void store_maint(int which)
 	while (st_ptr->stock_num < j) {
 		/* Mega-Hack -- ensure recall */
 		if (st_ptr->type == STORE_ALCH) {
-			int i;
 			object_type object_type_body;
 			int k_idx = lookup_kind(TV_SCROLL, SV_SCROLL_WORD_OF_RECALL);
 
@@ -3365,13 +3419,14 @@ void store_maint(int which)
 }
 
 /**
- * Maintain all the stores
+ * Maintain all the stores.
+ *
+ * The stock is only brought up to date when the player next walks in (see
+ * store_catch_up()), so this just notes the turnovers each store is owed.
  */
-
 void stores_maint(int times)
 {
-	int i, t, m = 0, n, max_stores, home, base;
-	bool big = FALSE;
+	int t, m = 0, n, max_stores, home, base;
 
 	/* Message */
 	if (OPT(cheat_xtra))
@@ -3388,35 +3443,22 @@ void stores_maint(int times)
 			home = max_stores - 1;
 		} else {
 			max_stores = MAX_STORES_BIG;
-			big = TRUE;
 			home = max_stores - 2;
 		}
 
 		/* Hack - record the first store */
 		base = m;
 
-		/* Maintain each shop (except home) - do Black Market last. */
+		/* Owe each shop (except home) its turnovers */
 		for (n = 0; n < max_stores; n++, m++) {
-			for (i = 0; i < times; i++) {
-				/* Ignore home */
-				if (n == home)
-					continue;
-
-				/* Save black market for last */
-				if (big && (n == (STORE_BLACKM)))
-					continue;
+			/* Ignore home */
+			if (n == home)
+				continue;
 
-				/* Maintain */
-				store_maint(m);
-			}
+			store[m].maint_due = MIN(store[m].maint_due + times,
+									 STORE_MAINT_MAX);
 		}
 
-		/* Now the Black Market */
-		for (i = 0; i < times; i++)
-			if (big)
-				store_maint(base + STORE_BLACKM);
-
-
 		/* Sometimes, shuffle the shop-keepers */
 		if (randint0(STORE_SHUFFLE) == 0) {
 			/* Message */
@@ -3475,6 +3517,7 @@ void store_init(void)
 		st_ptr->insult_cur = 0;
 		st_ptr->good_buy = 0;
 		st_ptr->bad_buy = 0;
+		st_ptr->maint_due = 0;
 
 		/* Nothing in stock */
 		st_ptr->stock_num = 0;
@@ -3491,6 +3534,6 @@ void store_init(void)
 			}
 	}
 
-	/* Maintain all stores 10 times */
-	stores_maint(10);
+	/* Stock all stores, as if after 10 turnovers, when first visited */
+	stores_maint(STORE_MAINT_MAX);
 }
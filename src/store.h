@@ -71,6 +71,8 @@ struct store_type {
 
     s32b store_wrap;	/**< Unused for now */
 
+    s16b maint_due;	/**< Turnovers owed since the player last visited */
+
     s16b table_num;	/**< Table -- Number of entries */
     s16b table_size;	/**< Table -- Total Size of Array */
     s16b *table;	/**< Table -- Legal item kinds */
@@ -87,7 +89,7 @@ extern const byte adj_chr_gold[STAT_RANGE];
 
 s32b price_item(object_type * o_ptr, int greed, bool flip);
 extern void store_shuffle(int which);
-extern void store_maint(int which);
+extern void store_maint(int which, int rounds);
 extern void stores_maint(int times);
 extern void store_init(void);
 
@@ -364,7 +364,11 @@ const char *window_flag_desc[32] =
     "Display item list",
     "Display borg messages",
     "Display borg status",
+#ifdef ALLOW_PROFILING
+    "Display performance counters",
+#else
     NULL,
+#endif
     NULL,
     NULL,
     NULL,
@@ -1653,7 +1653,7 @@ extern void py_steal(int y, int x)
 
 	/* Determine how much protection the monster has. */
 	theft_protection = (7 * (r_ptr->level + 2) / 4);
-	theft_protection += (m_ptr->mspeed - p_ptr->state.pspeed);
+	theft_protection += (mon_speed(m_ptr) - p_ptr->state.pspeed);
 	if (theft_protection < 1)
 		theft_protection = 1;
 
@@ -1740,8 +1740,8 @@ extern void py_steal(int y, int x)
 	if (randint1(4) != 1) {
 		m_ptr->csleep = 0;
 		m_ptr->mflag |= (MFLAG_ACTV);
-		if (m_ptr->mspeed < r_ptr->speed + 3)
-			m_ptr->mspeed += 10;
+		if (mon_speed(m_ptr) < r_ptr->speed + 3)
+			mon_speed(m_ptr) += 10;
 
 		/* Become hostile */
 		m_ptr->hostile = -1;
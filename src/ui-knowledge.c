@@ -1438,7 +1438,7 @@ static object_type *find_artifact(int a_idx)
 	int i, j;
 
 	/* Look for the artifact, either in inventory, store or the object list */
-	for (i = 0; i < z_info->o_max; i++) {
+	for (i = 0; i < o_max; i++) {
 		if (o_list[i].name1 == a_idx)
 			return &o_list[i];
 	}
@@ -322,7 +322,7 @@ static void do_cmd_options_win(const char *name, int row)
 		/* Move */
 		if (d != 0) {
 			x = (x + ddx[d] + 8) % ANGBAND_TERM_MAX;
-			y = (y + ddy[d] + 16) % PW_MAX_FLAGS;
+			y = (y + ddy[d] + PW_MAX_FLAGS) % PW_MAX_FLAGS;
 		}
 
 		/* Oops */
@@ -236,6 +236,10 @@ ui_event inkey_ex(void)
 	/* Hack -- Activate main screen */
 	Term_activate(term_screen);
 
+	/* Show anything held back by an open batch of events */
+	if (!character_icky)
+		event_flush_batch();
+
 
 	/* Get a key */
 	while (ke.type == EVT_NONE)
@@ -122,9 +122,13 @@ bool repair_mflag_mark;			/* Hack -- repair monster flags (mark) */
 
 s16b o_max = 1;					/* Number of allocated objects */
 s16b o_cnt = 0;					/* Number of live objects */
+s16b o_free = 0;				/* First dead object below o_max */
+s16b o_size = 0;				/* Size of the object list */
 
 s16b m_max = 1;					/* Number of allocated monsters */
 s16b m_cnt = 0;					/* Number of live monsters */
+s16b m_free = 0;				/* First dead monster below m_max */
+s16b m_size = 0;				/* Size of the monster list */
 
 s16b trap_max = 1;				/* Number of allocated traps */
 s16b trap_cnt = 0;				/* Number of live traps */
@@ -275,15 +279,26 @@ int cost_at_center = 0;
 trap_type *trap_list;
 
 /**
- * Array[z_info->o_max] of dungeon objects
+ * Array[o_size] of dungeon objects
  */
 object_type *o_list;
 
 /**
- * Array[z_info->m_max] of dungeon monsters
+ * Array[m_size] of dungeon monsters
  */
 monster_type *m_list;
 
+/**
+ * Arrays[m_size] of the scheduling information of dungeon monsters
+ */
+monster_hot m_hot;
+
+/**
+ * The monsters and floor objects of the level, by region
+ */
+region_index mon_regions;
+region_index obj_regions;
+
 /**
  * Array[z_info->m_max] of monster lore
  */
@@ -1854,6 +1854,37 @@ extern void do_cmd_spoilers(void);
 
 
 
+#ifdef ALLOW_PROFILING
+/**
+ * Dump the hot-path profiling counters to a CSV file, optionally
+ * resetting them afterwards.
+ */
+static void do_cmd_wiz_profile(void)
+{
+	char tmp_val[80];
+	char file_name[1024];
+
+	/* Ask for a file */
+	my_strcpy(tmp_val, "profile.csv", sizeof(tmp_val));
+	if (!get_string("File: ", tmp_val, sizeof(tmp_val)))
+		return;
+
+	path_build(file_name, sizeof(file_name), ANGBAND_DIR_USER, tmp_val);
+
+	/* Check for failure */
+	if (!prof_dump_csv(file_name)) {
+		msg("Profile dump failed.");
+		return;
+	}
+
+	msg("Profile dumped to %s.", tmp_val);
+
+	if (get_check("Reset the counters? "))
+		prof_reset();
+}
+#endif /* ALLOW_PROFILING */
+
+
 /**
  * Ask for and parse a "debug command"
  *
@@ -2007,6 +2038,17 @@ void do_cmd_debug(void)
 			break;
 		}
 
+#ifdef ALLOW_PROFILING
+
+		/* Dump the profiling counters */
+	case 'P':
+		{
+			do_cmd_wiz_profile();
+			break;
+		}
+
+#endif
+
 		/* Phase Door */
 	case 'p':
 		{
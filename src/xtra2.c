@@ -244,7 +244,7 @@ bool modify_panel(term * t, int wy, int wx)
 		t->offset_x = wx;
 
 		/* Redraw map */
-		p_ptr->redraw |= (PR_MAP);
+		p_ptr->redraw |= (PR_PANEL);
 
 		/* Redraw for big graphics */
 		if ((tile_width > 1) || (tile_height > 1))
@@ -1210,6 +1210,36 @@ prt_study,
 };
 
 
+/*
+ * Which term a subwindow display is in, and whether it needs redrawing.
+ */
+struct subwindow_flags {
+	int win_idx;
+	bool needs_redraw;
+};
+
+/*
+ * Note that a display built from many events needs redrawing, and say
+ * whether to redraw it now: only once, at the EVENT_END which closes each
+ * set of updates.
+ */
+static bool subwindow_redraw_due(struct subwindow_flags *flags,
+								 game_event_type type)
+{
+	if (type != EVENT_END) {
+		flags->needs_redraw = TRUE;
+		return FALSE;
+	}
+
+	if (!flags->needs_redraw)
+		return FALSE;
+
+	flags->needs_redraw = FALSE;
+	return TRUE;
+}
+
+static struct subwindow_flags statusline_data;
+
 /*
  * Print the status line.
  */
@@ -1220,6 +1250,9 @@ static void update_statusline(game_event_type type, game_event_data * data,
 	int col = 13;
 	size_t i;
 
+	if (!subwindow_redraw_due(&statusline_data, type))
+		return;
+
 	/* Clear the remainder of the line */
 	prt("", row, col);
 
@@ -1255,7 +1288,6 @@ static void update_maps(game_event_type type, game_event_data * data,
 	}
 	/* Single point to be redrawn */
 	else {
-		grid_data g;
 		int a;
 		byte ta;
 		wchar_t c, tc;
@@ -1307,8 +1339,7 @@ static void update_maps(game_event_type type, game_event_data * data,
 
 
 		/* Redraw the grid spot */
-		map_info(data->point.y, data->point.x, &g);
-		grid_data_as_text(&g, &a, &c, &ta, &tc);
+		map_glyph(data->point.y, data->point.x, &a, &c, &ta, &tc);
 		Term_queue_char(t, vx, vy, a, c, ta, tc);
 #if 0
 		/* Plot 'spot' updates in light green to make them visible */
@@ -1524,15 +1555,25 @@ static void update_messages_subwindow(game_event_type type,
 	Term_activate(old);
 }
 
-static struct minimap_flags {
-	int win_idx;
-	bool needs_redraw;
-} minimap_data[ANGBAND_TERM_MAX];
+static struct subwindow_flags minimap_data[ANGBAND_TERM_MAX];
+
+/**
+ * Tell display_map() about changes to the map, for every term it draws in.
+ * Whole-map redraws that change anything go through forget_map_glyphs().
+ */
+static void note_map_changes(game_event_type type, game_event_data * data,
+							 void *user)
+{
+	if ((data->point.x == -1) && (data->point.y == -1))
+		return;
+
+	display_map_note(data->point.y, data->point.x);
+}
 
 static void update_minimap_subwindow(game_event_type type,
 									 game_event_data * data, void *user)
 {
-	struct minimap_flags *flags = user;
+	struct subwindow_flags *flags = user;
 
 	if (type == EVENT_MAP) {
 		/* Set flag if whole-map redraw. */
@@ -1549,8 +1590,11 @@ static void update_minimap_subwindow(game_event_type type,
 		if (flags->needs_redraw)
 			Term_clear();
 
-		/* Redraw map */
-		display_map(NULL, NULL);
+		/* Redraw the map, or just what has changed */
+		if (flags->needs_redraw)
+			display_map(NULL, NULL);
+		else
+			display_map_changes();
 		Term_fresh();
 
 		/* Restore */
@@ -1564,11 +1608,17 @@ static void update_minimap_subwindow(game_event_type type,
 /*
  * Hack -- display player in sub-windows (mode 0)
  */
+static struct subwindow_flags player0_data[ANGBAND_TERM_MAX];
+
 static void update_player0_subwindow(game_event_type type,
 									 game_event_data * data, void *user)
 {
 	term *old = Term;
-	term *inv_term = user;
+	struct subwindow_flags *flags = user;
+	term *inv_term = angband_term[flags->win_idx];
+
+	if (!subwindow_redraw_due(flags, type))
+		return;
 
 	/* Activate */
 	Term_activate(inv_term);
@@ -1585,11 +1635,17 @@ static void update_player0_subwindow(game_event_type type,
 /*
  * Hack -- display player in sub-windows (mode 1)
  */
+static struct subwindow_flags player1_data[ANGBAND_TERM_MAX];
+
 static void update_player1_subwindow(game_event_type type,
 									 game_event_data * data, void *user)
 {
 	term *old = Term;
-	term *inv_term = user;
+	struct subwindow_flags *flags = user;
+	term *inv_term = angband_term[flags->win_idx];
+
+	if (!subwindow_redraw_due(flags, type))
+		return;
 
 	/* Activate */
 	Term_activate(inv_term);
@@ -1607,6 +1663,8 @@ static void update_player1_subwindow(game_event_type type,
 /*
  * Display the left-hand-side of the main term, in more compact fashion.
  */
+static struct subwindow_flags player_compact_data[ANGBAND_TERM_MAX];
+
 static void update_player_compact_subwindow(game_event_type type,
 											game_event_data * data,
 											void *user)
@@ -1616,7 +1674,11 @@ static void update_player_compact_subwindow(game_event_type type,
 	int i;
 
 	term *old = Term;
-	term *inv_term = user;
+	struct subwindow_flags *flags = user;
+	term *inv_term = angband_term[flags->win_idx];
+
+	if (!subwindow_redraw_due(flags, type))
+		return;
 
 	/* Activate */
 	Term_activate(inv_term);
@@ -1664,6 +1726,45 @@ static void update_player_compact_subwindow(game_event_type type,
 }
 
 
+#ifdef ALLOW_PROFILING
+/*
+ * Display the hot-path profiling counters.
+ */
+static void update_profile_subwindow(game_event_type type,
+									 game_event_data * data, void *user)
+{
+	term *old = Term;
+	term *inv_term = user;
+	int i;
+
+	/* Activate */
+	Term_activate(inv_term);
+
+	/* Header */
+	Term_putstr(0, 0, -1, TERM_L_BLUE,
+				"Section              Calls    Total ms   Avg us   Max us  Last us");
+	Term_erase(65, 0, 255);
+
+	/* One line per counter */
+	for (i = 0; i < PROF_MAX; i++) {
+		const prof_counter *c = prof_get(i);
+
+		Term_putstr(0, i + 1, -1, TERM_WHITE,
+					format("%-16s %9lu %11.1f %8.1f %8.0f %8.0f", c->name,
+						   (unsigned long) c->calls, c->total / 1000.0,
+						   c->calls ? c->total / c->calls : 0.0, c->max,
+						   c->last));
+		Term_erase(65, i + 1, 255);
+	}
+
+	Term_fresh();
+
+	/* Restore */
+	Term_activate(old);
+}
+#endif /* ALLOW_PROFILING */
+
+
 static void flush_subwindow(game_event_type type, game_event_data * data,
 							void *user)
 {
@@ -1715,28 +1816,43 @@ static void subwindow_flag_changed(int win_idx, u32b flag, bool new_state)
 
 	case PW_PLAYER_0:
 		{
+			player0_data[win_idx].win_idx = win_idx;
+			player0_data[win_idx].needs_redraw = TRUE;
+
 			set_register_or_deregister(player_events,
 									   N_ELEMENTS(player_events),
 									   update_player0_subwindow,
-									   angband_term[win_idx]);
+									   &player0_data[win_idx]);
+			register_or_deregister(EVENT_END, update_player0_subwindow,
+								   &player0_data[win_idx]);
 			break;
 		}
 
 	case PW_PLAYER_1:
 		{
+			player1_data[win_idx].win_idx = win_idx;
+			player1_data[win_idx].needs_redraw = TRUE;
+
 			set_register_or_deregister(player_events,
 									   N_ELEMENTS(player_events),
 									   update_player1_subwindow,
-									   angband_term[win_idx]);
+									   &player1_data[win_idx]);
+			register_or_deregister(EVENT_END, update_player1_subwindow,
+								   &player1_data[win_idx]);
 			break;
 		}
 
 	case PW_PLAYER_2:
 		{
+			player_compact_data[win_idx].win_idx = win_idx;
+			player_compact_data[win_idx].needs_redraw = TRUE;
+
 			set_register_or_deregister(player_events,
 									   N_ELEMENTS(player_events),
 									   update_player_compact_subwindow,
-									   angband_term[win_idx]);
+									   &player_compact_data[win_idx]);
+			register_or_deregister(EVENT_END, update_player_compact_subwindow,
+								   &player_compact_data[win_idx]);
 			break;
 		}
 
@@ -1802,6 +1918,15 @@ static void subwindow_flag_changed(int win_idx, u32b flag, bool new_state)
 								   angband_term[win_idx]);
 			break;
 		}
+
+#ifdef ALLOW_PROFILING
+	case PW_PROFILE:
+		{
+			register_or_deregister(EVENT_END, update_profile_subwindow,
+								   angband_term[win_idx]);
+			break;
+		}
+#endif /* ALLOW_PROFILING */
 	}
 }
 
@@ -2024,12 +2149,15 @@ static void ui_enter_game(game_event_type type, game_event_data * data,
 	 * large set of events. */
 	event_add_handler_set(statusline_events, N_ELEMENTS(statusline_events),
 						  update_statusline, NULL);
+	event_add_handler(EVENT_END, update_statusline, NULL);
 
 	/* Player HP can optionally change the colour of the '@' now. */
 	event_add_handler(EVENT_HP, hp_colour_change, NULL);
 
 	/* Simplest way to keep the map up to date - will do for now */
 	event_add_handler(EVENT_MAP, update_maps, angband_term[0]);
+	event_add_handler(EVENT_MAP, note_map_changes, NULL);
+	display_map_note(-1, -1);
 #if 0
 	event_add_handler(EVENT_MAP, trace_map_updates, angband_term[0]);
 #endif
@@ -2050,12 +2178,14 @@ static void ui_leave_game(game_event_type type, game_event_data * data,
 	event_remove_handler_set(statusline_events,
 							 N_ELEMENTS(statusline_events),
 							 update_statusline, NULL);
+	event_remove_handler(EVENT_END, update_statusline, NULL);
 
 	/* Player HP can optionally change the colour of the '@' now. */
 	event_remove_handler(EVENT_HP, hp_colour_change, NULL);
 
 	/* Simplest way to keep the map up to date - will do for now */
 	event_remove_handler(EVENT_MAP, update_maps, angband_term[0]);
+	event_remove_handler(EVENT_MAP, note_map_changes, NULL);
 #if 0
 	event_remove_handler(EVENT_MAP, trace_map_updates, angband_term[0]);
 #endif
@@ -0,0 +1,116 @@
+/*
+ * File: z-prof.c
+ * Purpose: Lightweight scoped timers and call counters for hot paths
+ *
+ * Copyright (c) 2026 FAangband contributors
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+#include "z-prof.h"
+#include "z-file.h"
+
+#ifdef ALLOW_PROFILING
+
+#ifdef WINDOWS
+# include <windows.h>
+#else
+# include <time.h>
+#endif
+
+static prof_counter counters[PROF_MAX] = {
+	#define PROF(a, b) { b, 0, 0, 0, 0, 0, 0 },
+	#include "list-prof-counters.h"
+	#undef PROF
+};
+
+double prof_now(void)
+{
+#ifdef WINDOWS
+	static LARGE_INTEGER freq;
+	LARGE_INTEGER now;
+
+	if (!freq.QuadPart)
+		QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+
+	return (double) now.QuadPart * 1000000.0 / (double) freq.QuadPart;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double) ts.tv_sec * 1000000.0 + (double) ts.tv_nsec / 1000.0;
+#endif
+}
+
+void prof_enter(enum prof_id id)
+{
+	prof_counter *c = &counters[id];
+
+	c->calls++;
+
+	/* Only the outermost call of a recursive section is timed */
+	if (c->depth++ == 0)
+		c->start = prof_now();
+}
+
+void prof_leave(enum prof_id id)
+{
+	prof_counter *c = &counters[id];
+
+	if (--c->depth == 0) {
+		c->last = prof_now() - c->start;
+		c->total += c->last;
+		if (c->last > c->max)
+			c->max = c->last;
+	}
+}
+
+const prof_counter *prof_get(enum prof_id id)
+{
+	return &counters[id];
+}
+
+void prof_reset(void)
+{
+	int i;
+
+	for (i = 0; i < PROF_MAX; i++) {
+		counters[i].calls = 0;
+		counters[i].total = 0;
+		counters[i].max = 0;
+		counters[i].last = 0;
+	}
+}
+
+bool prof_dump_csv(const char *path)
+{
+	ang_file *f = file_open(path, MODE_WRITE, FTYPE_TEXT);
+	int i;
+
+	if (!f)
+		return FALSE;
+
+	file_putf(f, "section,calls,total_us,avg_us,max_us,last_us\n");
+	for (i = 0; i < PROF_MAX; i++) {
+		const prof_counter *c = &counters[i];
+
+		file_putf(f, "%s,%lu,%.0f,%.1f,%.0f,%.0f\n", c->name,
+				  (unsigned long) c->calls, c->total,
+				  c->calls ? c->total / c->calls : 0.0, c->max, c->last);
+	}
+
+	file_close(f);
+	return TRUE;
+}
+
+#endif /* ALLOW_PROFILING */
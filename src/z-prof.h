@@ -0,0 +1,80 @@
+/*
+ * File: z-prof.h
+ * Purpose: Lightweight scoped timers and call counters for hot paths
+ *
+ * Copyright (c) 2026 FAangband contributors
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+#ifndef INCLUDED_Z_PROF_H
+#define INCLUDED_Z_PROF_H
+
+#include "h-basic.h"
+#include "config.h"
+
+/**
+ * The profiled sections, from list-prof-counters.h.
+ */
+enum prof_id {
+	#define PROF(a, b) PROF_##a,
+	#include "list-prof-counters.h"
+	#undef PROF
+	PROF_MAX
+};
+
+/**
+ * Accumulated figures for one section.  Times are in microseconds; a
+ * section entered recursively is only timed at the outermost level.
+ */
+typedef struct prof_counter {
+	const char *name;
+	u32b calls;
+	double total;
+	double max;
+	double last;
+	int depth;
+	double start;
+} prof_counter;
+
+#ifdef ALLOW_PROFILING
+
+/*
+ * Mark the start and end of a profiled section.  Every PROF_BEGIN() must be
+ * matched by a PROF_END() on each path out of the section.
+ */
+#define PROF_BEGIN(id)  prof_enter(PROF_##id)
+#define PROF_END(id)    prof_leave(PROF_##id)
+
+void prof_enter(enum prof_id id);
+void prof_leave(enum prof_id id);
+
+/* Monotonic clock, in microseconds from an arbitrary start */
+double prof_now(void);
+
+/* Get the counter for a section */
+const prof_counter *prof_get(enum prof_id id);
+
+/* Clear all counters */
+void prof_reset(void);
+
+/* Write all counters to a CSV file; returns FALSE on failure */
+bool prof_dump_csv(const char *path);
+
+#else /* ALLOW_PROFILING */
+
+/* Compiled out entirely */
+#define PROF_BEGIN(id)  ((void)0)
+#define PROF_END(id)    ((void)0)
+
+#endif /* ALLOW_PROFILING */
+
+#endif /* INCLUDED_Z_PROF_H */
@@ -760,6 +760,86 @@ void Term_queue_chars(int x, int y, int n, int a, const wchar_t *s)
 /*** Refresh routines ***/
 
 
+/*
+ * Unchanged parts of a row are skipped this many cells at a time, comparing
+ * each block of attrs and chars as a whole rather than cell by cell.
+ */
+#define FRESH_CHUNK	8
+
+/*
+ * A gap of at most this many unchanged cells between two changed runs is
+ * drawn again rather than skipped, as one longer hook call costs less than
+ * two short ones (and, for most terminals, a cursor motion).
+ */
+#define FRESH_GAP	4
+
+/*
+ * The old and new contents of one row, for the helpers below.  The terrain
+ * arrays are only compared when drawing with "Term_pict()".
+ */
+typedef struct
+{
+	const int *oa, *na, *ota, *nta;
+	const wchar_t *oc, *nc, *otc, *ntc;
+} fresh_row;
+
+/*
+ * Check whether the cell at column x has changed
+ */
+static inline bool Term_fresh_changed(const fresh_row *r, int x)
+{
+	if ((r->oa[x] != r->na[x]) || (r->oc[x] != r->nc[x])) return (TRUE);
+	if (r->ota && ((r->ota[x] != r->nta[x]) || (r->otc[x] != r->ntc[x])))
+		return (TRUE);
+	return (FALSE);
+}
+
+/*
+ * Return the first column from x on (up to x2 + 1) that may have changed,
+ * skipping whole chunks of unchanged cells where we can.
+ */
+static inline int Term_fresh_skip(const fresh_row *r, int x, int x2)
+{
+	size_t ai = FRESH_CHUNK * sizeof(int);
+	size_t ci = FRESH_CHUNK * sizeof(wchar_t);
+
+	while (x + FRESH_CHUNK <= x2 + 1)
+	{
+		if (memcmp(&r->oa[x], &r->na[x], ai) ||
+		    memcmp(&r->oc[x], &r->nc[x], ci))
+			break;
+		if (r->ota && (memcmp(&r->ota[x], &r->nta[x], ai) ||
+			       memcmp(&r->otc[x], &r->ntc[x], ci)))
+			break;
+		x += FRESH_CHUNK;
+	}
+
+	return (x);
+}
+
+/*
+ * Return the length of the run of unchanged cells starting at x if another
+ * changed cell follows within FRESH_GAP cells, or zero otherwise.  If "fa"
+ * is not -1, the gap and the following changed cell must all be in that
+ * attr, so that pending text can be extended over them.
+ */
+static inline int Term_fresh_gap(const fresh_row *r, int x, int x2, int fa)
+{
+	int i;
+
+	for (i = x; (i <= x2) && (i - x <= FRESH_GAP); i++)
+	{
+		/* Wrong colour */
+		if ((fa != -1) && (r->na[i] != fa)) return (0);
+
+		/* Found the next change */
+		if (Term_fresh_changed(r, i)) return (i - x);
+	}
+
+	return (0);
+}
+
+
 /*
  * Flush a row of the current window (see "Term_fresh")
  *
@@ -799,6 +879,9 @@ static void Term_fresh_row_pict(int y, int x1, int x2)
 	int na;
 	wchar_t nc;
 
+	fresh_row r = { old_aa, scr_aa, old_taa, scr_taa,
+			old_cc, scr_cc, old_tcc, scr_tcc };
+
 	/* Scan "modified" columns */
 	for (x = x1; x <= x2; x++)
 	{
@@ -819,6 +902,19 @@ static void Term_fresh_row_pict(int y, int x1, int x2)
 		/* Handle unchanged grids */
 		if ((na == oa) && (nc == oc) && (nta == ota) && (ntc == otc))
 		{
+			/* Draw over a short gap */
+			if (fn)
+			{
+				int gap = Term_fresh_gap(&r, x, x2, -1);
+
+				if (gap)
+				{
+					fn += gap;
+					x += gap - 1;
+					continue;
+				}
+			}
+
 			/* Flush */
 			if (fn)
 			{
@@ -831,6 +927,7 @@ static void Term_fresh_row_pict(int y, int x1, int x2)
 			}
 
 			/* Skip */
+			x = Term_fresh_skip(&r, x + 1, x2) - 1;
 			continue;
 		}
 
@@ -899,6 +996,9 @@ static void Term_fresh_row_both(int y, int x1, int x2)
 	int na;
 	wchar_t nc;
 
+	fresh_row r = { old_aa, scr_aa, old_taa, scr_taa,
+			old_cc, scr_cc, old_tcc, scr_tcc };
+
 	/* Scan "modified" columns */
 	for (x = x1; x <= x2; x++)
 	{
@@ -919,6 +1019,19 @@ static void Term_fresh_row_both(int y, int x1, int x2)
 		/* Handle unchanged grids */
 		if ((na == oa) && (nc == oc) && (nta == ota) && (ntc == otc))
 		{
+			/* Draw over a short gap in the same colour */
+			if (fn)
+			{
+				int gap = Term_fresh_gap(&r, x, x2, fa);
+
+				if (gap)
+				{
+					fn += gap;
+					x += gap - 1;
+					continue;
+				}
+			}
+
 			/* Flush */
 			if (fn)
 			{
@@ -939,6 +1052,7 @@ static void Term_fresh_row_both(int y, int x1, int x2)
 			}
 
 			/* Skip */
+			x = Term_fresh_skip(&r, x + 1, x2) - 1;
 			continue;
 		}
 
@@ -1061,6 +1175,8 @@ static void Term_fresh_row_text(int y, int x1, int x2)
 	int na;
 	wchar_t nc;
 
+	fresh_row r = { old_aa, scr_aa, NULL, NULL, old_cc, scr_cc, NULL, NULL };
+
 
 	/* Scan "modified" columns */
 	for (x = x1; x <= x2; x++)
@@ -1076,6 +1192,19 @@ static void Term_fresh_row_text(int y, int x1, int x2)
 		/* Handle unchanged grids */
 		if ((na == oa) && (nc == oc))
 		{
+			/* Draw over a short gap in the same colour */
+			if (fn)
+			{
+				int gap = Term_fresh_gap(&r, x, x2, fa);
+
+				if (gap)
+				{
+					fn += gap;
+					x += gap - 1;
+					continue;
+				}
+			}
+
 			/* Flush */
 			if (fn)
 			{
@@ -1096,6 +1225,7 @@ static void Term_fresh_row_text(int y, int x1, int x2)
 			}
 
 			/* Skip */
+			x = Term_fresh_skip(&r, x + 1, x2) - 1;
 			continue;
 		}
 
@@ -1324,6 +1454,9 @@ errr Term_fresh(void)
 		return (1);
 	}
 
+	/* Only real refreshes are profiled */
+	PROF_BEGIN(TERM_FRESH);
+
 
 	/* Paranoia -- use "fake" hooks to prevent core dumps */
 	if (!Term->curs_hook) Term->curs_hook = Term_curs_hack;
@@ -1571,6 +1704,8 @@ errr Term_fresh(void)
 	/* Actually flush the output */
 	Term_xtra(TERM_XTRA_FRESH, 0);
 
+	PROF_END(TERM_FRESH);
+
 
 	/* Success */
 	return (0);
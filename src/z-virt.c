@@ -20,6 +20,9 @@
 
 unsigned int mem_flags = 0;
 
+unsigned long mem_allocs = 0;
+unsigned long mem_alloc_bytes = 0;
+
 #define SZ(uptr)	*((size_t *)((char *)(uptr) - sizeof(size_t)))
 
 /*
@@ -46,6 +49,9 @@ void *mem_alloc(size_t len)
 		memset(mem, 0xCC, len);
 	SZ(mem) = len;
 
+	mem_allocs++;
+	mem_alloc_bytes += len;
+
 	return mem;
 }
 
@@ -79,6 +85,9 @@ void *mem_realloc(void *p, size_t len)
 	if (!m) quit("Out of Memory!");
 	SZ(m) = len;
 
+	mem_allocs++;
+	mem_alloc_bytes += len;
+
 	return m;
 }
 
@@ -69,4 +69,8 @@ enum {
 
 extern unsigned int mem_flags;
 
+/* Running totals of mem_alloc() calls and bytes requested */
+extern unsigned long mem_allocs;
+extern unsigned long mem_alloc_bytes;
+
 #endif /* INCLUDED_Z_VIRT_H */